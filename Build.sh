@@ -43,6 +43,7 @@ cd ../;
 # Install executables and py script to ~/home/user/.bin
 mkdir -p ~/.bin;
 cp ./build/AutoDepMocker ~/.bin/;
+cp ./build/libAutoDepMockerPlugin.so ~/.bin/;
 cp ./Scripts/AutoDepMocker_YoctoCMake.py ~/.bin/;
 
 # Export ~/.bin
@@ -22,8 +22,8 @@
 # @Note:
 # ------
 #  1. There is a limit for command line arguments in linux system
-#     It will fail when a project's cmake has huge include and link dependencies.
-#       Todo: Do not include the full path, Instead create a symbolic link to recipe-sysroot and use that
+#     Include directories are written to a response file(AutoDepMockerFlags.rsp next to recipe-sysroot) and passed as
+#     @AutoDepMockerFlags.rsp, AutoDepMocker expands it and drops repeated include directories
 
 import os
 import subprocess
@@ -139,20 +139,25 @@ class CompilerSetting:
             return finalList
 
     def __formCompilerSetting(self, fileName, sysrootDir, cxxIncludeDirs, sourceFileDirs, buildDirlist, buildNijaIncludes):
-        compilerSetting = "~/.bin/AutoDepMocker " + fileName + " -- --sysroot=" + sysrootDir + " --target=arm-v5-nvidia-linux-hard -mfpu=neon -mfloat-abi=hard -march=armv7-a -mthumb -ferror-limit=1000000 -I" \
+        # System headers of the recipe are precompiled once and reused by every later run for this recipe
+        responseFile = sysrootDir.strip() + "/../AutoDepMockerFlags.rsp"
+        compilerSetting = "~/.bin/AutoDepMocker --sysroot-pch=" + sysrootDir.strip() + "/../AutoDepMockerPCH " + fileName + " -- --sysroot=" + sysrootDir + " --target=arm-v5-nvidia-linux-hard -mfpu=neon -mfloat-abi=hard -march=armv7-a -mthumb -ferror-limit=1000000 -I" \
                            + sysrootDir.strip() + "/usr/include/"
 
         if -1 != fileName.find(".cpp"):
             compilerSetting += " --std=c++17 "
 
-        for item in cxxIncludeDirs:
-            compilerSetting += " -I" + item
-        for item in sourceFileDirs:
-            compilerSetting += " -I" + item
-        for item in buildDirlist:
-            compilerSetting += " -I" + item
-        for item in buildNijaIncludes:
-            compilerSetting += " " + item
+        # One flag per line, Kept out of the command line
+        with open(responseFile, 'w') as file:
+            for item in cxxIncludeDirs:
+                file.write("-I" + item + "\n")
+            for item in sourceFileDirs:
+                file.write("-I" + item + "\n")
+            for item in buildDirlist:
+                file.write("-I" + item + "\n")
+            for item in buildNijaIncludes:
+                file.write(item + "\n")
+        compilerSetting += " @" + responseFile
 
         return compilerSetting
 
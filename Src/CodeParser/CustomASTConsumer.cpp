@@ -21,18 +21,28 @@
 
 #include <iostream>
 
+#include "llvm/ADT/SmallString.h"
+
 #include "CustomASTConsumer.hpp"
-#include "GMockClassGenerator.hpp"
+#include "MockFileEmitter.hpp"
+
+namespace {
+
+// Memory usage visits every source buffer, Too expensive for each of the many small top-level declarations
+const unsigned memorySampleInterval = 64;
 
-CustomASTConsumer::CustomASTConsumer(clang::SourceManager& sourceManager)
-    : m_sourceManager(sourceManager) {
+}
+
+CustomASTConsumer::CustomASTConsumer(clang::SourceManager& sourceManager, const ParserSettings& settings)
+    : m_sourceManager(sourceManager)
+    , m_settings(settings) {
 }
 
 // This method is called only once when ast is generated, Ready to traverse generated ast
 void CustomASTConsumer::HandleTranslationUnit(clang::ASTContext& context) {
 
     // Create CustomASTConsumer
-    m_customASTvisitor = std::make_unique<CustomASTVisitor>(context, m_sourceManager);
+    m_customASTvisitor = std::make_unique<CustomASTVisitor>(context, m_sourceManager, m_settings);
 
     // Get all declaration and visit one by one
     auto decList = context.getTranslationUnitDecl()->decls();
@@ -47,48 +57,85 @@ void CustomASTConsumer::HandleTranslationUnit(clang::ASTContext& context) {
         m_customASTvisitor->TraverseDecl(each);
     }
 
+    if(m_settings.includedFilesSink) {
+        collectIncludedFiles(context.getSourceManager());
+    }
+
+    if(m_settings.memoryUsageSink) {
+        *m_settings.memoryUsageSink = getMemoryUsage(context);
+    }
+
     // Parsing done, Generate Mock class
     generateMockFiles();
 }
 
-// Get necessary information from CustomASTVisitor and invoke MockGenerator
-void CustomASTConsumer::generateMockFiles() {
+void CustomASTConsumer::Initialize(clang::ASTContext& context) {
+    m_context = &context;
+}
 
-    GMockClassGenerator gmockGenerator;
-    IMockGenerator& mockGenerator = gmockGenerator;
+bool CustomASTConsumer::HandleTopLevelDecl(clang::DeclGroupRef /*declGroup*/) {
+    const bool timeExceeded = (std::chrono::steady_clock::now() > m_settings.deadline);
+    const bool memoryExceeded = m_settings.memoryLimit && (0 == (++m_topLevelDeclCount % memorySampleInterval)) &&
+                                (getMemoryUsage(*m_context) > m_settings.memoryLimit);
+    if(! timeExceeded && ! memoryExceeded) {
+        return true;
+    }
 
-    // Write include information first
-    const IncludeInfo& includeInfo = m_customASTvisitor->getIncludeInfo();
-    for(const auto& each : includeInfo) {
-        mockGenerator.constructIncludes(each.first, each.second);
+    std::cerr << "Parsing of " << m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())->getName().str()
+              << " stopped, " << (timeExceeded ? "Time" : "Memory") << " limit exceeded" << std::endl;
+    if(m_settings.incompleteSink) {
+        *m_settings.incompleteSink = true;
     }
 
-    // Write Enums
-    const EnumInfo& enumInfo = m_customASTvisitor->getEnumInfo();
-    for(const auto& itr : enumInfo) {
-        mockGenerator.constructEnum(itr.first, itr.second);
+    // Parser returns without handling the translation unit, So collect what is there
+    HandleTranslationUnit(*m_context);
+    return false;
+}
+
+std::size_t CustomASTConsumer::getMemoryUsage(clang::ASTContext& context) {
+    const clang::SourceManager& sourceManager = context.getSourceManager();
+    const clang::SourceManager::MemoryBufferSizes bufferSizes = sourceManager.getMemoryBufferSizes();
+    return context.getASTAllocatedMemory() + context.getSideTableAllocatedMemory() +
+           sourceManager.getContentCacheSize() + sourceManager.getDataStructureSizes() +
+           bufferSizes.malloc_bytes + bufferSizes.mmap_bytes;
+}
+
+bool CustomASTConsumer::shouldSkipFunctionBody(clang::Decl* decl) {
+    if(! m_settings.skipFunctionBodiesOutsideMainFile) {
+        return false;
     }
 
-    // Write C++ classes
-    const auto [classInfo, classMethodsInfo] = m_customASTvisitor->getMockclassInfoAndMethods();
-    for(const auto& itr : classInfo) {
-        mockGenerator.constructClass(itr.second, classMethodsInfo.at(itr.first));
+    // Functions defined by macros belong to the file the macro is expanded in
+    const clang::SourceLocation location = m_sourceManager.getExpansionLoc(decl->getLocation());
+    return m_sourceManager.getMainFileID() != m_sourceManager.getFileID(location);
+}
+
+void CustomASTConsumer::collectIncludedFiles(clang::SourceManager& sourceManager) {
+    clang::FileManager& fileManager = sourceManager.getFileManager();
+    for(auto it = sourceManager.fileinfo_begin(); it != sourceManager.fileinfo_end(); ++it) {
+        llvm::SmallString<256> path(it->first->getName());
+        fileManager.makeAbsolutePath(path);
+        m_settings.includedFilesSink->push_back(path.str());
     }
+}
+
+// Get necessary information from CustomASTVisitor and invoke MockGenerator
+void CustomASTConsumer::generateMockFiles() {
+
+    MockModel model = m_customASTvisitor->takeMockModel();
 
-    // Write C functions
-    const CFunctionInfoType& cFunctionsInfo = m_customASTvisitor->getCMockFunctions();
-    for(const auto& each : cFunctionsInfo) {
-        mockGenerator.constructCFunction(each.first, each.second);
+    // Model is merged with other translation units and written later
+    if(m_settings.modelSink) {
+        *m_settings.modelSink = std::move(model);
+        return;
     }
 
-    // Write field declaration
-    const std::map<std::string/*fileName*/, std::list<VariableInfoHierarchy>>& varInfo = m_customASTvisitor->getVariableInfoContainer();
-   for(const auto& each : varInfo) {
-        mockGenerator.constructFieldDeclation(each.first, each.second);
-   }
+    MockFileEmitter mockFileEmitter;
+    mockFileEmitter.emit(model);
 
-    // Finish mocking
-    mockGenerator.finalizeMocking();
+    if(! m_settings.printGenerationBanner) {
+        return;
+    }
 
     std::cout << "\33[1;35m\nMock files have been generated to GeneratedMocks folder. Feel free to customize the content of these files to suit the specific requirements of your project.\033[0m\n";
     std::cout << "\33[1;35m\nCopyright information is left blank in generated files. Please add it according to your project.\033[0m\n";
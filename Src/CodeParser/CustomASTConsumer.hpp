@@ -33,11 +33,12 @@
 #include "EnumGenerator.hpp"
 #include "CPPMockGenerator.hpp"
 #include "CMockGenerator.hpp"
+#include "ParserSettings.hpp"
 
 class CustomASTConsumer : public clang::ASTConsumer {
 public:
 
-    explicit CustomASTConsumer(clang::SourceManager& sourceManager);
+    explicit CustomASTConsumer(clang::SourceManager& sourceManager, const ParserSettings& settings = {});
     ~CustomASTConsumer() = default;
 
     /** Handle translation unit
@@ -48,16 +49,47 @@ public:
     // This function is called only once when ast is generated, Ready to traverse generated ast
     void HandleTranslationUnit(clang::ASTContext& context) override;
 
+    // Keep the context, Declarations parsed so far are visited when a limit stops parsing
+    void Initialize(clang::ASTContext& context) override;
+
+    /** Handle top level declaration
+     * @brief: Invoked by the parser after each top-level declaration. Checks the limits of the settings
+     * @arg declGroup: Parsed declarations
+     * @return bool: false stops parsing, Mock information of the declarations parsed so far is collected then
+     */
+    bool HandleTopLevelDecl(clang::DeclGroupRef declGroup) override;
+
+    /** Should skip function body
+     * @brief: Invoked by the parser for each function body when skipping function bodies is enabled.
+     *         Bodies outside the main file are skipped, Sema still parses bodies it needs(constexpr, deduced return type)
+     * @arg decl: Function whose body is about to be parsed
+     * @return bool: true when the body shall be skipped
+     */
+    bool shouldSkipFunctionBody(clang::Decl* decl) override;
+
 private:
     /** Generate mock files
      * @brief: Handle the generation of mock files which include enums, C++ methods, and C functions
      */
     void generateMockFiles();
 
+    // Store every file known to the source manager in includedFilesSink of the settings
+    void collectIncludedFiles(clang::SourceManager& sourceManager);
+
+    // AST and source buffers of the translation unit in bytes
+    static std::size_t getMemoryUsage(clang::ASTContext& context);
+
     // ASTContext
     clang::SourceManager& m_sourceManager;
 
+    ParserSettings m_settings;
+
     std::unique_ptr<CustomASTVisitor> m_customASTvisitor = {};
+
+    clang::ASTContext* m_context = nullptr;
+
+    // Top-level declarations handled so far, The memory limit is checked only every few of them
+    unsigned m_topLevelDeclCount = 0;
 };
 
 #endif // CUSTOMASTCONSUMER_HPP
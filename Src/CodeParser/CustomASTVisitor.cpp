@@ -22,13 +22,36 @@
 #include "CustomASTVisitor.hpp"
 #include "CustomFrontendAction.hpp"
 #include "CustomASTConsumer.hpp"
+#include "Logger.hpp"
+#include "MockModelMerger.hpp"
 
-CustomASTVisitor::CustomASTVisitor(clang::ASTContext& ASTContext, clang::SourceManager& sourceManager)
+#include "llvm/Support/Path.h"
+
+namespace {
+
+// include/c++/7.5.0 => c++ std files
+const char* const stdFilePatterns[] = {"include/c++/", "include/x86_64-linux-gnu/c++"};
+
+}
+
+CustomASTVisitor::CustomASTVisitor(clang::ASTContext& ASTContext, clang::SourceManager& sourceManager,
+                                   const ParserSettings& settings)
     : m_ASTContext(ASTContext)
-    , m_sourceManager(sourceManager) {
+    , m_sourceManager(sourceManager)
+    , m_mockPolicy(settings.mockPolicy) {
+
+    // Batch runs parse many translation units in parallel, No user to answer
+    if(! settings.askInteractiveMode) {
+        askUserConfirmation = false;
+        return;
+    }
+
+    // The policy answers instead of the user, Only files it has no rule for are asked while recording
+    if(m_mockPolicy) {
+        askUserConfirmation = m_mockPolicy->isRecording();
+        return;
+    }
 
-    // Truncate and open the log file
-    logFile.open("AutoDepMocker.log", std::ofstream::out | std::ofstream::trunc);
     std::cout << "\33[1;35m\nInteractive mode provides the flexibility to select which files to mock based on your preferences" << std::endl;
     std::cout << "So would you like to execute in interative mode?[y/n]\033[0m: ";
     std::string input;
@@ -40,44 +63,37 @@ CustomASTVisitor::CustomASTVisitor(clang::ASTContext& ASTContext, clang::SourceM
     }
 }
 
-CustomASTVisitor::~CustomASTVisitor() {
-    logFile.close();
-}
-
 // Ignore buildin types, c++ std types and types which are defined in same source file
 // Parse and mock only types which are defined in externel file
 bool CustomASTVisitor::VisitVarDecl(clang::VarDecl* variableDecl)
 {
-    logFile << "INFO: VisitVarDecl: " << variableDecl->getDeclName().getAsString() << std::endl;
+    LOG_DEBUG("VisitVarDecl: " << variableDecl->getDeclName().getAsString());
 
     // Ignore buildin types
     if(variableDecl->getType()->isBuiltinType()) {
-        logFile << "INFO: buildin type found, Skipping" << std::endl;
+        LOG_INFO("buildin type found, Skipping");
         return true;
     }
 
     // Ignore c++ std types
     if(variableDecl->isInStdNamespace()) {
-        logFile << "INFO: c++ std type found, Skipping" << std::endl;
+        LOG_INFO("c++ std type found, Skipping");
         return true;
     }
 
     // Skip if the declaration origin is from the same source file
-    const std::string sourcefileName = getfileNameFromPath(
-                m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())->getName());
-    const auto declFileName = getFileNameFromTypeDeclaration(const_cast<clang::Type*>(
-                variableDecl->getType().getTypePtrOrNull())).value_or(std::string());
-
-    const auto declFileNameStripped = getfileNameFromPath(declFileName);
+    const clang::TagDecl* tagDecl = getTagDeclOfType(const_cast<clang::Type*>(variableDecl->getType().getTypePtrOrNull()));
+    const FileClassification* declFile = tagDecl ? &classifyFile(tagDecl->getLocation()) : nullptr;
 
-    if(declFileNameStripped.empty()) {
-        logFile << "WARN: Unable to get declaration file name, Skipping" << std::endl;
+    if(! declFile || declFile->fileName.empty()) {
+        LOG_WARN("Unable to get declaration file name, Skipping");
         return true;
     }
-    if(sourcefileName == declFileNameStripped) {
-        logFile << "INFO: Declaration origin is source file, Skipping" << std::endl;
+    if(FileKind::MainFile == declFile->kind) {
+        LOG_INFO("Declaration origin is source file, Skipping");
         return true;
     }
+    const std::string declFileNameStripped = declFile->fileName.str();
 
     // Get declaration name
     std::string childInfo = getTypeNameFromQualifiedTypeName(
@@ -94,11 +110,11 @@ bool CustomASTVisitor::VisitVarDecl(clang::VarDecl* variableDecl)
 // It supports parsing C/C++ Enums
 bool CustomASTVisitor::VisitDeclRefExpr(const clang::DeclRefExpr* declRefExpr) {
 
-    logFile << "INFO: VisitDeclRefExpr: " << declRefExpr->getNameInfo().getAsString() << std::endl;
+    LOG_DEBUG("VisitDeclRefExpr: " << declRefExpr->getNameInfo().getAsString());
 
     // operator overload functions show up as C function
     if(std::string::npos != declRefExpr->getNameInfo().getAsString().find("operator")) {
-        logFile << "INFO: Operator overload function found in VisitDeclRefExpr, skipping" << std::endl;
+        LOG_INFO("Operator overload function found in VisitDeclRefExpr, skipping");
         return true;
     }
 
@@ -107,19 +123,19 @@ bool CustomASTVisitor::VisitDeclRefExpr(const clang::DeclRefExpr* declRefExpr) {
     // Also C functions do not have basetype, So this would collapse incase of c file
     const clang::ValueDecl* valueDecl = declRefExpr->getDecl();
     if(! valueDecl) {
-        logFile << "INFO: Unable to find declaration, Skipping" << std::endl;
+        LOG_INFO("Unable to find declaration, Skipping");
         return false;
     }
 
     auto* baseType = valueDecl->getType().getBaseTypeIdentifier();
     if(! baseType) {
-        logFile << "INFO: build in type found, Skipping" << std::endl;
+        LOG_INFO("build in type found, Skipping");
         return true;
     }
 
     const clang::Type* declType = declRefExpr->getType().getTypePtr();
     if(! declType) {
-        logFile << "WARN: Unable to get declaration type" << std::endl;
+        LOG_WARN("Unable to get declaration type");
         return true;
     }
 
@@ -132,26 +148,27 @@ bool CustomASTVisitor::VisitDeclRefExpr(const clang::DeclRefExpr* declRefExpr) {
 }
 
 bool CustomASTVisitor::VisitMemberExpr(const clang::MemberExpr* memberExpr) {
-    logFile << "INFO: VisitMemberExpr, member name: " << memberExpr->getMemberNameInfo().getAsString() << std::endl;
-    logFile << "INFO: VisitMemberExpr, member type: " << memberExpr->getMemberDecl()->getType().getAsString() << std::endl;
+    LOG_DEBUG("VisitMemberExpr, member name: " << memberExpr->getMemberNameInfo().getAsString());
+    LOG_DEBUG("VisitMemberExpr, member type: " << memberExpr->getMemberDecl()->getType().getAsString());
 
     // Skip member function expression
     if(clang::isa<clang::FunctionDecl>(memberExpr->getMemberDecl())) {
         return true; // nothing to do
     }
 
-    // Skip if the declaration origin is from the same source file
-    const std::string sourcefileName = getfileNameFromPath(
-                m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())->getName());
-
+    // Every access of the member leads to the same result
     clang::ValueDecl* valueDecl = memberExpr->getMemberDecl();
-    const std::string declFileNameStripped = getfileNameFromPath(getStrippedFilePath(
-                                        m_sourceManager.getFilename(valueDecl->getLocation()).data()));
+    if(! m_visitedDecls.insert(valueDecl->getCanonicalDecl()).second) {
+        return true;
+    }
 
-    if(sourcefileName == declFileNameStripped) {
-        logFile << "INFO: Declaration origin is source file, Skipping" << std::endl;
+    // Skip if the declaration origin is from the same source file
+    const FileClassification& declFile = classifyFile(valueDecl->getLocation());
+    if(FileKind::MainFile == declFile.kind) {
+        LOG_INFO("Declaration origin is source file, Skipping");
         return true;
     }
+    const std::string declFileNameStripped = declFile.fileName.str();
 
     const std::string childInfo = memberExpr->getMemberDecl()->getType().getAsString() + 
                     PredefinedMockData::aSpace + memberExpr->getMemberNameInfo().getAsString();
@@ -166,14 +183,14 @@ bool CustomASTVisitor::VisitCallExpr(clang::CallExpr* callExpression) {
     // @Note: getDirectCallee() seems to return nullptr for cast expression. But callExpression->getCalleeDecl() would work
     // However cast expressions can be skipped
     if(! callExpression->getDirectCallee()) {
-        logFile << "WARN: Suspecious CallExpr found, Skipping" << std::endl;
+        LOG_WARN("Suspecious CallExpr found, Skipping");
         return true;
     }
-    logFile << "INFO: VisitCallExpr, callee " << callExpression->getDirectCallee()->getNameAsString().c_str() << std::endl;
+    LOG_DEBUG("VisitCallExpr, callee " << callExpression->getDirectCallee()->getNameAsString());
 
     clang::Expr* calleeExpr = callExpression->getCallee();
     if(! calleeExpr) {
-        logFile << "WARN: Unable to get callee from call expression" << std::endl;
+        LOG_WARN("Unable to get callee from call expression");
         return true;
     }
 
@@ -210,13 +227,13 @@ const IncludeInfo& CustomASTVisitor::getIncludeInfo() {
 void CustomASTVisitor::parseCXXMemberExpression(clang::CallExpr* callEpr) {
 
     if(! callEpr) {
-        logFile << "WARN: Invalid call expression" << std::endl;
+        LOG_WARN("Invalid call expression");
         return;
     }
 
     clang::CXXMethodDecl* methodDecl = clang::dyn_cast<clang::CXXMethodDecl>(callEpr->getDirectCallee());
     if(! methodDecl) {
-        logFile << "WARN: Unable to get CXXMethodDeclaration from callee" << std::endl;
+        LOG_WARN("Unable to get CXXMethodDeclaration from callee");
         return;
     }
 
@@ -229,13 +246,13 @@ void CustomASTVisitor::parseCXXMemberExpression(clang::CallExpr* callEpr) {
 void CustomASTVisitor::parseCFunction(clang::CallExpr* callExpr) {
 
     if(! callExpr || ! callExpr->getDirectCallee()) {
-        logFile << "WARN: callExpr or callee is invalid" << std::endl;
+        LOG_WARN("callExpr or callee is invalid");
         return;
     }
 
     // @Note: operator overload functions show up as C function
     if(callExpr->getDirectCallee()->isOverloadedOperator()) { // Right way
-        logFile << "INFO: Operator overload function found" << std::endl;
+        LOG_INFO("Operator overload function found");
         clang::CXXMethodDecl* cxxMethodDec = clang::dyn_cast_or_null<clang::CXXMethodDecl>(callExpr->getDirectCallee()->getAsFunction());
         if(cxxMethodDec) {
             ParseOperatorOverloading(cxxMethodDec);
@@ -245,49 +262,51 @@ void CustomASTVisitor::parseCFunction(clang::CallExpr* callExpr) {
 
     clang::Expr* calleeExpr = callExpr->getCallee();
     if(! calleeExpr) {
-        logFile << "WARN: Unable to get callee from call expression" << std::endl;
+        LOG_WARN("Unable to get callee from call expression");
         return;
     }
 
     // Get Declaration from callee Expression
     clang::Decl* refDecl = calleeExpr->getReferencedDeclOfCallee();
     if(! refDecl) {
-        logFile << "WARN: Unable to cast to reference declaration" << std::endl;
+        LOG_WARN("Unable to cast to reference declaration");
         return;
     }
 
     // Get function declaration from declaration
     clang::FunctionDecl* functionDecl = refDecl->getAsFunction();
     if(! functionDecl) {
-        logFile << "WARN: Unable to cast to function declaration" << std::endl;
+        LOG_WARN("Unable to cast to function declaration");
+        return;
+    }
+
+    // Every call site of the function leads to the same result
+    if(! m_visitedDecls.insert(functionDecl->getCanonicalDecl()).second) {
         return;
     }
 
-    // Functions originating from the same source file
-    const std::string SourcefileName = getfileNameFromPath(m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())->getName());
-    const std::string currentFileName = getfileNameFromPath(m_sourceManager.getFilename(functionDecl->getLocation())).data();
-    std::string currentFileNameStripped = currentFileName.substr(0, currentFileName.find(".")); // To include header file as well
-    logFile << "INFO: File stripped: " << currentFileNameStripped << std::endl;
-    if(std::string::npos != SourcefileName.find(currentFileNameStripped)) {
-        logFile << "INFO: Source file function found, skipping" << std::endl;
+    // Functions originating from the same source file, Header of the source file as well
+    FileClassification& file = classifyFile(functionDecl->getLocation());
+    if((FileKind::MainFile == file.kind) || (FileKind::MainFileStem == file.kind)) {
+        LOG_INFO("Source file function found, skipping");
         return;
     }
 
     // Is it from c++ std
     if(functionDecl->getDeclContext()->isStdNamespace()) {
-        logFile << "INFO: std function found, skipping" << std::endl;
+        LOG_INFO("std function found, skipping");
         return;
     }
 
     // @Note: Sometimes data shows up empty
-    if(! m_sourceManager.getFilename(functionDecl->getLocation()).data()) {
-        logFile << "WARN: Couldn't find file name, skipping" << std::endl;
+    if(file.filePath.empty()) {
+        LOG_WARN("Couldn't find file name, skipping");
         return;
     }
 
-    std::string fileName = getfileNameFromPath(m_sourceManager.getFilename(functionDecl->getLocation()).data());
-    if(! fileContentToBeMocked(m_sourceManager.getFilename(functionDecl->getLocation()).data(), functionDecl->getNameAsString())) {
-        logFile << "INFO: Not mocking - " << functionDecl->getNameAsString() << std::endl;
+    std::string fileName = file.fileName.str();
+    if(! fileContentToBeMocked(file, functionDecl->getQualifiedNameAsString())) {
+        LOG_INFO("Not mocking - " << functionDecl->getNameAsString());
         return;
     }
 
@@ -296,26 +315,24 @@ void CustomASTVisitor::parseCFunction(clang::CallExpr* callExpr) {
         m_CFunctionInfo[fileName] = {};
     }
 
-    // Is function information already noted
-    for(const auto& each : m_CFunctionInfo.at(fileName)) {
-        if(each.name == functionDecl->getNameAsString()) {
-            logFile << "INFO: Function information already present, Skipping" << std::endl;
-            return;
-        }
+    // Is function information already noted, Overloads share the name
+    if(! m_cFunctionNames[fileName].insert(functionDecl->getNameAsString()).second) {
+        LOG_INFO("Function information already present, Skipping");
+        return;
     }
 
     // Finally store it
     MethodInfo methodInfo;
     methodInfo.name = functionDecl->getNameAsString();
     methodInfo.returnType = checkBool(functionDecl->getReturnType().getAsString());
-    logFile << "INFO: Store the file name of return type defined: " << methodInfo.returnType.c_str() << std::endl;
+    LOG_DEBUG("Store the file name of return type defined: " << methodInfo.returnType.str());
     storeIncludeInformation(const_cast<clang::Type*>(functionDecl->getReturnType().getTypePtr()), fileName);
     // get args
-    std::vector<std::string> argsInfo;
+    std::vector<InternedString> argsInfo;
     for(int i=0; i<functionDecl->getNumParams(); i++) {
         argsInfo.push_back(checkBool(functionDecl->getParamDecl(i)->getType().getAsString()));
-        logFile << "INFO: Store the file name of function arg defined: " <<
-                   functionDecl->getParamDecl(i)->getType().getAsString().c_str() << std::endl;
+        LOG_DEBUG("Store the file name of function arg defined: " <<
+                  functionDecl->getParamDecl(i)->getType().getAsString());
         storeIncludeInformation(const_cast<clang::Type*>(functionDecl->getParamDecl(i)->getType().getTypePtr()), fileName);
     }
     methodInfo.args = argsInfo;
@@ -328,7 +345,12 @@ void CustomASTVisitor::parseCFunction(clang::CallExpr* callExpr) {
 // Example: enum name { ONE, TWO }; || enum class name { ONE, TWO };
 void CustomASTVisitor::parseEnum(const clang::DeclRefExpr* declRefExpr, const clang::Type* declType/*helper*/) {
     if(! declRefExpr || ! declRefExpr->getDecl()) {
-        logFile << "WARN: Invalid declaration reference expression" << std::endl;
+        LOG_WARN("Invalid declaration reference expression");
+        return;
+    }
+
+    // Every reference to the enum value leads to the same result
+    if(! m_visitedDecls.insert(declRefExpr->getDecl()->getCanonicalDecl()).second) {
         return;
     }
 
@@ -338,17 +360,16 @@ void CustomASTVisitor::parseEnum(const clang::DeclRefExpr* declRefExpr, const cl
             getAsString().substr(5); // Remove "Enum" keyword
 
     // Check declaration belonging to Main file
-    const std::string sourceFileName = getfileNameFromPath(m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())->getName());
-    const std::string currentfileName = getfileNameFromPath(m_sourceManager.getFilename(declRefExpr->getDecl()->getLocation()).data());
-    const std::string fileNameStripped = currentfileName.substr(0, currentfileName.find("."));
-    if(std::string::npos != sourceFileName.find(fileNameStripped)) {
-        logFile << "INFO: Enum belonging to Main source file, Skipping" << std::endl;
+    FileClassification& file = classifyFile(declRefExpr->getDecl()->getLocation());
+    if((FileKind::MainFile == file.kind) || (FileKind::MainFileStem == file.kind)) {
+        LOG_INFO("Enum belonging to Main source file, Skipping");
         return;
     }
+    const std::string currentfileName = file.fileName.str();
 
-    const std::string enumNameFound = getEnumNameFromFullyQualifiedEnumName(enumFullName);
-    logFile << "INFO: Enum name" << enumNameFound << ", Enum full name: " << enumFullName << std::endl;
-    const std::string valueFound = declRefExpr->getNameInfo().getAsString();
+    const InternedString enumNameFound = getEnumNameFromFullyQualifiedEnumName(enumFullName);
+    LOG_INFO("Enum name" << enumNameFound.str() << ", Enum full name: " << enumFullName);
+    const InternedString valueFound = declRefExpr->getNameInfo().getAsString();
 
     bool isEnumStored = false;
     bool isEnumValueStored = false;
@@ -380,12 +401,12 @@ void CustomASTVisitor::parseEnum(const clang::DeclRefExpr* declRefExpr, const cl
 
     // Enum and Enum value already stored, Nothing to do
     if(isEnumStored && isEnumValueStored) {
-        logFile << "INFO: Enum value is already stored, skipping" << std::endl;
+        LOG_INFO("Enum value is already stored, skipping");
         return;
     }
 
     // Enum and enum value are not stored yet
-    if(! fileContentToBeMocked(m_sourceManager.getFilename(declRefExpr->getDecl()->getLocation()).data(), enumNameFound)) {
+    if(! fileContentToBeMocked(file, enumFullName)) {
         return; // Not mocking as user not interested
     }
 
@@ -409,7 +430,7 @@ void CustomASTVisitor::parseEnum(const clang::DeclRefExpr* declRefExpr, const cl
 
 void CustomASTVisitor::ParseOperatorOverloading(clang::CXXMethodDecl* cxxMethodDec) {
     if(! cxxMethodDec->getParent()) {
-        logFile << "WARN: Unable to get parent of CXXMethodDecl" << std::endl;
+        LOG_WARN("Unable to get parent of CXXMethodDecl");
         return;
     }
 
@@ -418,85 +439,44 @@ void CustomASTVisitor::ParseOperatorOverloading(clang::CXXMethodDecl* cxxMethodD
 
 void CustomASTVisitor::StoreClassAndMethodInfo(clang::CXXMethodDecl* methodDecl, bool operatorOverloadingType) {
     if(! methodDecl || ! methodDecl->getParent()) {
-        logFile << "WARN: Unable to get parent declaration of CXXMethodDecl" << std::endl;
+        LOG_WARN("Unable to get parent declaration of CXXMethodDecl");
         return;
     }
 
-    // @Note: Fetching FileId didn't work. So workaround has been added to get file name and compare against the source file
-    const std::string SourcefileName = getfileNameFromPath(m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())->getName());
-    const std::string currentFileName = getfileNameFromPath(m_sourceManager.getFilename(methodDecl->getParent()->getLocation())).data();
-    std::string currentFileNameStripped = currentFileName.substr(0, currentFileName.find("."));
-    logFile << "INFO: File stripped: " << currentFileNameStripped << std::endl;
-    if(std::string::npos != SourcefileName.find(currentFileNameStripped)) {
-        logFile << "INFO: Source class member function found, skipping" << std::endl;
+    // Every call site of the method leads to the same result
+    if(! m_visitedDecls.insert(methodDecl->getCanonicalDecl()).second) {
         return;
     }
 
-    const std::string className = methodDecl->getParent()->getNameAsString();
-
-    if(! fileContentToBeMocked(m_sourceManager.getFilename(methodDecl->getParent()->getLocation()).data(), className)) {
+    // Class of the source file or its header
+    FileClassification& file = classifyFile(methodDecl->getParent()->getLocation());
+    if((FileKind::MainFile == file.kind) || (FileKind::MainFileStem == file.kind)) {
+        LOG_INFO("Source class member function found, skipping");
         return;
     }
 
-    ClassInfo classInfo = {};
-    classInfo.name = methodDecl->getParent()->getNameAsString();
-    classInfo.fullName = methodDecl->getParent()->getQualifiedNameAsString(); // Useless
-    
-    // Default declaration kind name is "class"
-    if(methodDecl->getParent()->isStruct()) {
-        classInfo.declKindName = PredefinedMockData::struct_;
-    } else if(methodDecl->getParent()->isUnion()) {
-        classInfo.declKindName = PredefinedMockData::union_;
-    }
-
-    // Read Namespace information
-    const clang::DeclContext* declContext = methodDecl->getParent()->getEnclosingNamespaceContext();
-    if (const clang::NamespaceDecl* namespaceDecl = clang::dyn_cast<clang::NamespaceDecl>(declContext)) {
-        // Make sure namespace information is stored in the right order
-        classInfo.namespaceInfo.insert(classInfo.namespaceInfo.begin(), namespaceDecl->getNameAsString());
-        // If there are parent namespaces, Add them too
-        const clang::DeclContext* parentDeclContext = namespaceDecl->getParent();
-        while (parentDeclContext && clang::isa<clang::NamespaceDecl>(parentDeclContext)) { // Loop over to fetch namespace information
-            namespaceDecl = clang::cast<clang::NamespaceDecl>(parentDeclContext);
-            classInfo.namespaceInfo.insert(classInfo.namespaceInfo.begin(), namespaceDecl->getNameAsString());
-            parentDeclContext = namespaceDecl->getParent();
-        }
+    if(! fileContentToBeMocked(file, methodDecl->getQualifiedNameAsString())) {
+        return;
     }
 
-    // Check if the class is template class
-    if(methodDecl->getParent()->getTemplateInstantiationPattern()) {
-        if(! methodDecl->getParent()->getTemplateInstantiationPattern()) {
-            logFile << "WARN: Unable to get Template instantiation pattern of CXXRecordDecl" << std::endl;
+    // Class information is read once per class
+    const clang::CXXRecordDecl* recordDecl = methodDecl->getParent()->getCanonicalDecl();
+    auto recordClassInfo = m_recordClassInfo.find(recordDecl);
+    if(m_recordClassInfo.end() == recordClassInfo) {
+        ClassInfo classInfo = {};
+        if(! readClassInfo(methodDecl->getParent(), classInfo)) {
             return;
         }
-        if(! methodDecl->getParent()->getTemplateInstantiationPattern()->getDescribedClassTemplate()) {
-            logFile << "WARN: Unable to get Described Class Template from CXXRecordDecl" << std::endl;
-            return;
-        }
-        if(! methodDecl->getParent()->getTemplateInstantiationPattern()->getDescribedClassTemplate()->getTemplateParameters()) {
-            logFile << "WARN: Unable to get Template parameter list from ClassTempDecl" << std::endl;
-            return;
-        }
-        clang::TemplateParameterList* templateParamList = methodDecl->getParent()->getTemplateInstantiationPattern()->getDescribedClassTemplate()->getTemplateParameters();
-        std::vector<std::string> tempParamList;
-        for(int i=0; i<templateParamList->size(); i++) {
-            tempParamList.push_back(templateParamList->getParam(i)->getNameAsString());
+        // Keyed by qualified name, Classes of the same name in different namespaces are different mocks
+        m_mockClassInfo[classInfo.fullName] = classInfo;
+        if(! m_mockCPPMethodInfo.count(classInfo.fullName)) {
+            m_mockCPPMethodInfo[classInfo.fullName] = {};
         }
-
-        classInfo.isTemplateClass = true;
-        classInfo.templateParams = tempParamList;
+        recordClassInfo = m_recordClassInfo.insert({recordDecl, std::move(classInfo)}).first;
     }
-
-    classInfo.filename = getfileNameFromPath(m_sourceManager.getFilename(methodDecl->getParent()->getLocation()));
-    logFile << "INFO: Filename: " << classInfo.filename << std::endl;
-    logFile << "INFO: Class full name: " << classInfo.fullName << std::endl;
-
-    m_mockClassInfo[classInfo.name] = classInfo;
+    const ClassInfo& classInfo = recordClassInfo->second;
 
     // Store callee information, RVALUE
-    if(! m_mockCPPMethodInfo.count(classInfo.name)) {
-        m_mockCPPMethodInfo[classInfo.name] = {};
-    }
     MethodInfo methodInfo = {};
     clang::FunctionDecl* functionDecl = {};
     if(classInfo.isTemplateClass) { // UnWrap the template instance
@@ -505,43 +485,94 @@ void CustomASTVisitor::StoreClassAndMethodInfo(clang::CXXMethodDecl* methodDecl,
         functionDecl = clang::dyn_cast_or_null<clang::FunctionDecl>(methodDecl);
     }
     if(! functionDecl) {
-        logFile << "WARN: Unable to get function declaration for member expression" << std::endl;
+        LOG_WARN("Unable to get function declaration for member expression");
         return;
     }
 
-    // Is Method information already stored
-    for(const auto& eachMethod : m_mockCPPMethodInfo.at(classInfo.name)) {
-        if(eachMethod.name == functionDecl->getNameAsString()) {
-            // Fill up arguments for comparision
-            std::vector<std::string> argsInfo;
-            for(int i=0; i<functionDecl->getNumParams(); i++) {
-                argsInfo.push_back(checkBool(functionDecl->getParamDecl(i)->getType().getAsString())); // Decl always has a type
-            }
-            if(argsInfo == eachMethod.args) {
-                logFile << "INFO: callee Information is already present, skipping" << std::endl;
-                return;
-            }
-        }
+    // Instances of a template class share the pattern
+    if((functionDecl != methodDecl) && ! m_visitedDecls.insert(functionDecl->getCanonicalDecl()).second) {
+        LOG_INFO("callee Information is already present, skipping");
+        return;
     }
 
     // Store method information
     methodInfo.name = functionDecl->getNameAsString();
     methodInfo.returnType = checkBool(functionDecl->getReturnType().getAsString());
-    logFile << "INFO: Store the file name of return type defined: " << methodInfo.returnType.c_str() << std::endl;
-    storeIncludeInformation(const_cast<clang::Type*>(functionDecl->getReturnType().getTypePtr()), classInfo.filename);
     methodInfo.isConst = methodDecl->isConst();
     methodInfo.isTemplated = functionDecl->isTemplated();
-    std::vector<std::string> argsInfo;
+    std::vector<InternedString> argsInfo;
     for(int i=0; i<functionDecl->getNumParams(); i++) {
         argsInfo.push_back(checkBool(functionDecl->getParamDecl(i)->getType().getAsString())); // Decl always has a type
-        logFile << "INFO: Store the file name of function arg defined: " << functionDecl->getParamDecl(i)->getType().getAsString().c_str() << std::endl;
-        storeIncludeInformation(const_cast<clang::Type*>(functionDecl->getParamDecl(i)->getType().getTypePtr()), classInfo.filename);
     }
     methodInfo.args = argsInfo;
     methodInfo.isOperatorOverloading = operatorOverloadingType;
 
+    // Declarations of the same class share their methods
+    if(! m_classMethodSignatures[classInfo.fullName].insert(MockModelMerger::getMethodSignature(methodInfo)).second) {
+        LOG_INFO("callee Information is already present, skipping");
+        return;
+    }
+
+    LOG_DEBUG("Store the file name of return type defined: " << methodInfo.returnType.str());
+    storeIncludeInformation(const_cast<clang::Type*>(functionDecl->getReturnType().getTypePtr()), classInfo.filename);
+    for(int i=0; i<functionDecl->getNumParams(); i++) {
+        LOG_DEBUG("Store the file name of function arg defined: " << functionDecl->getParamDecl(i)->getType().getAsString());
+        storeIncludeInformation(const_cast<clang::Type*>(functionDecl->getParamDecl(i)->getType().getTypePtr()), classInfo.filename);
+    }
+
     // Finally link callee information with caller
-    m_mockCPPMethodInfo[classInfo.name].push_back(methodInfo);
+    m_mockCPPMethodInfo[classInfo.fullName].push_back(methodInfo);
+}
+
+bool CustomASTVisitor::readClassInfo(clang::CXXRecordDecl* recordDecl, ClassInfo& classInfo) {
+    classInfo.name = recordDecl->getNameAsString();
+    classInfo.fullName = recordDecl->getQualifiedNameAsString(); // Key of the class in the model
+
+    // Default declaration kind name is "class"
+    if(recordDecl->isStruct()) {
+        classInfo.declKindName = PredefinedMockData::struct_;
+    } else if(recordDecl->isUnion()) {
+        classInfo.declKindName = PredefinedMockData::union_;
+    }
+
+    // Read Namespace information
+    const clang::DeclContext* declContext = recordDecl->getEnclosingNamespaceContext();
+    if (const clang::NamespaceDecl* namespaceDecl = clang::dyn_cast<clang::NamespaceDecl>(declContext)) {
+        // Make sure namespace information is stored in the right order
+        classInfo.namespaceInfo.insert(classInfo.namespaceInfo.begin(), namespaceDecl->getNameAsString());
+        // If there are parent namespaces, Add them too
+        const clang::DeclContext* parentDeclContext = namespaceDecl->getParent();
+        while (parentDeclContext && clang::isa<clang::NamespaceDecl>(parentDeclContext)) { // Loop over to fetch namespace information
+            namespaceDecl = clang::cast<clang::NamespaceDecl>(parentDeclContext);
+            classInfo.namespaceInfo.insert(classInfo.namespaceInfo.begin(), namespaceDecl->getNameAsString());
+            parentDeclContext = namespaceDecl->getParent();
+        }
+    }
+
+    // Check if the class is template class
+    if(recordDecl->getTemplateInstantiationPattern()) {
+        if(! recordDecl->getTemplateInstantiationPattern()->getDescribedClassTemplate()) {
+            LOG_WARN("Unable to get Described Class Template from CXXRecordDecl");
+            return false;
+        }
+        if(! recordDecl->getTemplateInstantiationPattern()->getDescribedClassTemplate()->getTemplateParameters()) {
+            LOG_WARN("Unable to get Template parameter list from ClassTempDecl");
+            return false;
+        }
+        clang::TemplateParameterList* templateParamList = recordDecl->getTemplateInstantiationPattern()->getDescribedClassTemplate()->getTemplateParameters();
+        std::vector<InternedString> tempParamList;
+        for(int i=0; i<templateParamList->size(); i++) {
+            tempParamList.push_back(templateParamList->getParam(i)->getNameAsString());
+        }
+
+        classInfo.isTemplateClass = true;
+        classInfo.templateParams = tempParamList;
+    }
+
+    classInfo.filename = classifyFile(recordDecl->getLocation()).fileName.str();
+    LOG_INFO("Filename: " << classInfo.filename.str());
+    LOG_INFO("Class full name: " << classInfo.fullName.str());
+    return true;
 }
 
 void CustomASTVisitor::processParentInfoOfDeclaration(clang::DeclContext* parentDeclContext, const std::string& inputChildInfo,
@@ -587,7 +618,7 @@ void CustomASTVisitor::processParentInfoOfDeclaration(clang::DeclContext* parent
 }
 
 void CustomASTVisitor::storeVariableDeclationInfo(const std::string& childInfo, const std::string& parentInfo, const std::string& fileName, const bool finalEntry) {
-    logFile << "INFO: Storing variable, child: " << childInfo << " parent " << parentInfo << std::endl;
+    LOG_DEBUG("Storing variable, child: " << childInfo << " parent " << parentInfo);
 
     std::string parentInfoLocal = parentInfo;
     std::string childInfoLocal = childInfo;
@@ -609,10 +640,10 @@ void CustomASTVisitor::storeVariableDeclationInfo(const std::string& childInfo,
 
     if(parentInfo == "") {// Probably last entry
         if(m_variableInfo.size()) {
-            const std::vector<std::string> varInfoList(m_variableInfo.begin(), m_variableInfo.end());
+            const std::vector<InternedString> varInfoList(m_variableInfo.begin(), m_variableInfo.end());
             storeListInfoContainer(fileName, varInfoList);
         } else { // Only child present and no parent
-            std::vector<std::string> varInfoList = {childInfo};
+            std::vector<InternedString> varInfoList = {childInfo};
             storeListInfoContainer(fileName, varInfoList); // Organize this
         }
         // Flush out m_variableInfo
@@ -629,7 +660,7 @@ void CustomASTVisitor::storeVariableDeclationInfo(const std::string& childInfo,
     }
 }
 
-void CustomASTVisitor::storeListInfoContainerCore(const std::vector<std::string>& varInfoList, 
+void CustomASTVisitor::storeListInfoContainerCore(const std::vector<InternedString>& varInfoList, 
                           VariableInfoHierarchy& container, const bool newEntry) {
 
     VariableInfoHierarchy* current = &container;
@@ -687,7 +718,7 @@ void CustomASTVisitor::storeListInfoContainerCore(const std::vector<std::string>
     }
 }
 
-void CustomASTVisitor::storeListInfoContainer(const std::string& fileName, const std::vector<std::string>& varInfoList) {
+void CustomASTVisitor::storeListInfoContainer(const std::string& fileName, const std::vector<InternedString>& varInfoList) {
     // Check for any matches in existing container map
     // If file entry not exists, create one
     if(! m_variableInfoContainerMap.count(fileName)) {
@@ -741,14 +772,10 @@ void CustomASTVisitor::storeIncludeInformation(clang::Type* type, const std::str
         }
 
         // Is include file already noted
-        bool found = false;
-        for(const auto includeFile : m_includes.at(fileName)) {
-            if(includeFile == includeFileName.value()) {
-                found = true;
-            }
-        }
-        if(! found) {
-            m_includes.at(fileName).push_back(includeFileName.value());
+        const InternedString includeFile = includeFileName.value();
+        std::vector<InternedString>& fileIncludes = m_includes.at(fileName);
+        if(fileIncludes.end() == std::find(fileIncludes.begin(), fileIncludes.end(), includeFile)) {
+            fileIncludes.push_back(includeFile);
         }
     }
 }
@@ -760,94 +787,28 @@ void CustomASTVisitor::storeIncludeInformation(clang::Type* type, const std::str
 //             from a wrapper file(ex: string -> basic_string.h)
 //             WorkAround: Include bits/stdc++.h to simply include everything
 std::optional<std::string> CustomASTVisitor::getFileNameFromTypeDeclaration(clang::Type* type) {
-    if(! type) {
-        logFile << "WARN: Type is empty, Unable to process. Skipping" << std::endl;
-        return {};
-    }
-    if(type->isBuiltinType()) {
-        logFile << "INFO: Build in type found, Skipping" << std::endl;
-        return {};
-    }
-
-    // Type could be pointer, reference or pure type
-    // Below code unwraps pointer and reference type to pure type
-    clang::Type* typePtr = {};
-
-    if(type->isReferenceType()) {
-        const clang::ReferenceType* referType = type->getAs<clang::ReferenceType>();
-        if(! referType) {
-            logFile << "WARN: Unable to get reference type from type" << std::endl;
-            return {};
-        }
-        typePtr = const_cast<clang::Type*>(referType->getPointeeType().getTypePtr());
-        if(! typePtr) {
-            logFile << "WARN: Unable to get type pointer from pointee type" << std::endl;
-            return {};
-        }
-    } else if (type->isPointerType()) {
-        const clang::PointerType* pointerType = type->getAs<clang::PointerType>();
-        if(! pointerType) {
-            logFile << "WARN: Unable to get pointer type from type" << std::endl;
-            return {};
-        }
-        typePtr = const_cast<clang::Type*>(pointerType->getPointeeType().getTypePtr());
-        if(! typePtr) {
-            logFile << "WARN: Unable to get type pointer from pointee type" << std::endl;
-            return {};
-        }
-    }
-
-    if(typePtr) {
-        // Finally get declaration tagged with type
-        const clang::TagType* tagType = typePtr->getAs<clang::TagType>();
-        if(! tagType) {
-            logFile << "WARN: Unable to get tag type from type pointer" << std::endl;
-            logFile << "WARN: Is in build type: " << typePtr->isBuiltinType() << std::endl;
-            return {};
-        }
-
-        if(! tagType->getDecl()) {
-            logFile << "WARN: Unable to get declaration from tag type" << std::endl;
-            return {};
-        }
-
-        // File location would show up invalid for unknown files
-        if(! m_sourceManager.getFilename(tagType->getDecl()->getLocation()).data()) {
-            logFile << "WARN: Unable to get file location from tag type declaration" << std::endl;
-            return {};
-        }
-
-        return getStrippedFilePath(m_sourceManager.getFilename(tagType->getDecl()->getLocation()).data());
-    }
-
-    // Not wrapped
-    const clang::TagType* tagType = type->getAs<clang::TagType>();
-    if(! tagType) {
-        logFile << "WARN: Unable to get tag type from type" << std::endl;
-        return {};
-    }
-
-    if(! tagType->getDecl()) {
-        logFile << "WARN: Unable to get declaration from tag type" << std::endl;
+    const clang::TagDecl* tagDecl = getTagDeclOfType(type);
+    if(! tagDecl) {
         return {};
     }
 
     // File location would show up invalid for unknown files
-    if(! m_sourceManager.getFilename(tagType->getDecl()->getLocation()).data()) {
-        logFile << "WARN: Unable to get file location from tag type declaration" << std::endl;
+    const FileClassification& file = classifyFile(tagDecl->getLocation());
+    if(file.filePath.empty()) {
+        LOG_WARN("Unable to get file location from tag type declaration");
         return {};
     }
 
-    return getStrippedFilePath(m_sourceManager.getFilename(tagType->getDecl()->getLocation()).data());
+    return getStrippedFilePath(file.filePath.str());
 }
 
-clang::DeclContext* CustomASTVisitor::getParentOfType(clang::Type* type) {
+clang::TagDecl* CustomASTVisitor::getTagDeclOfType(clang::Type* type) {
     if(! type) {
-        logFile << "WARN: Type is empty, Unable to process. Skipping" << std::endl;
+        LOG_WARN("Type is empty, Unable to process. Skipping");
         return nullptr;
     }
     if(type->isBuiltinType()) {
-        logFile << "INFO: Build in type found, Skipping" << std::endl;
+        LOG_INFO("Build in type found, Skipping");
         return nullptr;
     }
 
@@ -858,23 +819,23 @@ clang::DeclContext* CustomASTVisitor::getParentOfType(clang::Type* type) {
     if(type->isReferenceType()) {
         const clang::ReferenceType* referType = type->getAs<clang::ReferenceType>();
         if(! referType) {
-            logFile << "WARN: Unable to get reference type from type" << std::endl;
+            LOG_WARN("Unable to get reference type from type");
             return nullptr;
         }
         typePtr = const_cast<clang::Type*>(referType->getPointeeType().getTypePtr());
         if(! typePtr) {
-            logFile << "WARN: Unable to get type pointer from pointee type" << std::endl;
+            LOG_WARN("Unable to get type pointer from pointee type");
             return nullptr;
         }
     } else if (type->isPointerType()) {
         const clang::PointerType* pointerType = type->getAs<clang::PointerType>();
         if(! pointerType) {
-            logFile << "WARN: Unable to get pointer type from type" << std::endl;
+            LOG_WARN("Unable to get pointer type from type");
             return nullptr;
         }
         typePtr = const_cast<clang::Type*>(pointerType->getPointeeType().getTypePtr());
         if(! typePtr) {
-            logFile << "WARN: Unable to get type pointer from pointee type" << std::endl;
+            LOG_WARN("Unable to get type pointer from pointee type");
             return nullptr;
         }
     }
@@ -882,17 +843,24 @@ clang::DeclContext* CustomASTVisitor::getParentOfType(clang::Type* type) {
     // Finally get declaration tagged with type
     const clang::TagType* tagType = typePtr->getAs<clang::TagType>();
     if(! tagType) {
-        logFile << "WARN: Unable to get tag type from type pointer" << std::endl;
-        logFile << "WARN: Is in build type: " << typePtr->isBuiltinType() << std::endl;
+        LOG_WARN("Unable to get tag type from type");
         return nullptr;
     }
     if(! tagType->getDecl()) {
-        logFile << "WARN: Unable to get declaration from tag type" << std::endl;
+        LOG_WARN("Unable to get declaration from tag type");
+        return nullptr;
+    }
+    return tagType->getDecl();
+}
+
+clang::DeclContext* CustomASTVisitor::getParentOfType(clang::Type* type) {
+    clang::TagDecl* tagDecl = getTagDeclOfType(type);
+    if(! tagDecl) {
         return nullptr;
     }
 
     // Return parent information
-    return tagType->getDecl()->getParent();
+    return tagDecl->getParent();
 }
 
 // Utility function to remove "/usr/include"
@@ -930,33 +898,49 @@ bool CustomASTVisitor::isStdNamespace(const std::string namespaceInfo) {
 
 // Mock or not to Mock is decided based on the file
 // Once file is choosen to not mock, Then content of that file will not be mocked in further findings
-bool CustomASTVisitor::fileContentToBeMocked(const std::string& fileName, const std::string& className) {
-
-    // include/c++/7.5.0 => c++ std files
-    // Already user confirmed files
-
-    // Do mock
-    for(const auto& each : tobeMockedFiles) {
-        int pos = 0;
-        pos = fileName.find(each);
-        if(std::string::npos != pos) {
-            // File content can be mocked
-            return true;
+bool CustomASTVisitor::fileContentToBeMocked(FileClassification& file, const std::string& symbolName) {
+
+    // Symbol rules of the policy are more specific than the decision of the file
+    if(m_mockPolicy) {
+        const MockPolicy::Decision decision = m_mockPolicy->decideSymbol(symbolName);
+        if(MockPolicy::Decision::None != decision) {
+            return MockPolicy::Decision::Mock == decision;
         }
     }
 
-    // Do not mock
-    for(const auto& each : notTobeMockedFiles) {
-        int pos = 0;
-        pos = fileName.find(each);
-        if(std::string::npos != pos) {
-            // File content should not be mocked
-            return false;
+    // Decided for this file before
+    if(FileKind::Mocked == file.kind) {
+        return true;
+    }
+    if((FileKind::NotMocked == file.kind) || (FileKind::Std == file.kind)) {
+        return false;
+    }
+
+    const bool toBeMocked = fileContentToBeMockedByName(file.filePath.str(), symbolName);
+    if(FileKind::Unknown == file.kind) {
+        file.kind = toBeMocked ? FileKind::Mocked : FileKind::NotMocked;
+    }
+    return toBeMocked;
+}
+
+bool CustomASTVisitor::fileContentToBeMockedByName(const std::string& fileName, const std::string& symbolName) {
+
+    // Already user confirmed files, The same file might be seen with another clang::FileID
+    const auto answer = m_fileAnswers.find(fileName);
+    if(m_fileAnswers.end() != answer) {
+        return answer->second;
+    }
+
+    // Path rules of the policy
+    if(m_mockPolicy) {
+        const MockPolicy::Decision decision = m_mockPolicy->decidePath(fileName);
+        if(MockPolicy::Decision::None != decision) {
+            return MockPolicy::Decision::Mock == decision;
         }
     }
 
     // New file found, Ask user
-    logFile << "INFO: To be mocked? fileName: " << fileName << ", className: " << className << "" << std::endl;
+    LOG_DEBUG("To be mocked? fileName: " << fileName << ", symbolName: " << symbolName);
     std::string input = "y";
     if(askUserConfirmation) {
         static bool askOnce = false;
@@ -965,22 +949,58 @@ bool CustomASTVisitor::fileContentToBeMocked(const std::string& fileName, const
             std::cout << "\n\33[1;43mBelow are the list of files identified as dependencies to your source file\033[0m\n";
             std::cout << "\33[1;43mSo press \"y\" if you want to mock the file content, \"n\" otherwise\033[0m\n" << std::endl;
         }
-        std::cout << "\33[1m" <<fileName << "(" << className << "): \033[0m";
+        std::cout << "\33[1m" <<fileName << "(" << symbolName << "): \033[0m";
         std::cin >> input;
         std::cout << std::endl;
+
+        // Replayed by the next run without asking
+        if(m_mockPolicy && m_mockPolicy->isRecording()) {
+            m_mockPolicy->recordAnswer(fileName, std::string("y") == input);
+        }
     }
-    if(std::string("y") == input) {
-        tobeMockedFiles.push_back(std::string(fileName));
-        return true;
-    }
-    notTobeMockedFiles.push_back(std::string(fileName));
-    return false;
+    m_fileAnswers[fileName] = (std::string("y") == input);
+    return m_fileAnswers[fileName];
 }
 
 std::string CustomASTVisitor::getfileNameFromPath(const std::string& filePath) {
     return std::filesystem::path(filePath).filename();
 }
 
+CustomASTVisitor::FileClassification& CustomASTVisitor::classifyFile(clang::SourceLocation location) {
+    const clang::FileID fileID = m_sourceManager.getFileID(location);
+    const auto found = m_fileClassifications.find(fileID);
+    if(m_fileClassifications.end() != found) {
+        return found->second;
+    }
+
+    // Main file is known only once the source file is entered, So it is looked up on first use
+    if(m_mainFileName.empty()) {
+        if(const clang::FileEntry* mainFile = m_sourceManager.getFileEntryForID(m_sourceManager.getMainFileID())) {
+            m_mainFileName = getfileNameFromPath(mainFile->getName());
+        }
+    }
+
+    FileClassification file;
+    if(const clang::FileEntry* fileEntry = m_sourceManager.getFileEntryForID(fileID)) {
+        file.filePath = fileEntry->getName();
+        file.fileName = llvm::sys::path::filename(file.filePath);
+    }
+
+    // File name without extension is compared, To include header file as well
+    const llvm::StringRef fileNameStripped = file.fileName.substr(0, file.fileName.find('.'));
+    if(file.fileName == m_mainFileName) {
+        file.kind = FileKind::MainFile;
+    } else if(std::string::npos != m_mainFileName.find(fileNameStripped.str())) {
+        file.kind = FileKind::MainFileStem;
+    } else if(std::any_of(std::begin(stdFilePatterns), std::end(stdFilePatterns),
+                          [&file](const char* each) { return llvm::StringRef::npos != file.filePath.find(each); })) {
+        file.kind = FileKind::Std;
+    }
+    LOG_DEBUG("File classified: " << file.filePath.str() << ", kind: " << static_cast<int>(file.kind));
+
+    return m_fileClassifications[fileID] = file;
+}
+
 // Qualified type name - struct ns::foo::bar::buz
 // Return - struct buz
 std::string CustomASTVisitor::getTypeNameFromQualifiedTypeName(const std::string& qualifiedTypeName) {
@@ -1000,4 +1020,15 @@ std::string CustomASTVisitor::getTypeNameFromQualifiedTypeName(const std::string
 
 const std::map<std::string/*fileName*/, std::list<VariableInfoHierarchy>>& CustomASTVisitor::getVariableInfoContainer() {
     return m_variableInfoContainerMap;
-}
\ No newline at end of file
+}
+
+MockModel CustomASTVisitor::takeMockModel() {
+    MockModel model;
+    model.includes = std::move(m_includes);
+    model.classInfo = std::move(m_mockClassInfo);
+    model.classMethodInfo = std::move(m_mockCPPMethodInfo);
+    model.cFunctionInfo = std::move(m_CFunctionInfo);
+    model.enumInfo = std::move(m_enumInfo);
+    model.variableInfo = std::move(m_variableInfoContainerMap);
+    return model;
+}
@@ -35,15 +35,21 @@
 #include <optional>
 
 #include "clang/AST/RecursiveASTVisitor.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/StringSet.h"
 
 #include "MockGeneratorTypes.hpp"
+#include "MockPolicy.hpp"
+#include "ParserSettings.hpp"
 
 class CustomASTVisitor : public clang::RecursiveASTVisitor<CustomASTVisitor> {
 public:
 
-    explicit CustomASTVisitor(clang::ASTContext& ASTContext, clang::SourceManager& sourceManager);
+    explicit CustomASTVisitor(clang::ASTContext& ASTContext, clang::SourceManager& sourceManager,
+                              const ParserSettings& settings = {});
 
-    ~CustomASTVisitor();
+    ~CustomASTVisitor() = default;
 
     /** Visitor for variable declaration
      * @brief: This gets called for each variable declaration
@@ -98,8 +104,31 @@ public:
     // Getter function for variable information container
     const std::map<std::string/*fileName*/, std::list<VariableInfoHierarchy>>& getVariableInfoContainer();
 
+    // Move all collected information out of the visitor. Call this once parsing is completely done
+    MockModel takeMockModel();
+
 private:
 
+    // How declarations of a file are treated, Decided once per clang::FileID
+    enum class FileKind : uint8_t {
+        Unknown,      // Not decided yet, Decided by fileContentToBeMocked() on first use
+        MainFile,     // Same file name as the main file
+        MainFileStem, // File name without extension is part of the main file name(e.g. header of the main file)
+        Std,          // C++ standard library
+        Mocked,
+        NotMocked
+    };
+
+    struct FileClassification {
+        FileKind kind = FileKind::Unknown;
+        llvm::StringRef filePath; // Owned by the FileManager, Empty when the location has no file
+        llvm::StringRef fileName; // Without directory
+    };
+
+    // Classification of the file containing the location, Computed on first use of its clang::FileID.
+    // Returned reference is valid until the next call
+    FileClassification& classifyFile(clang::SourceLocation location);
+
     // Parse C++ member expression
     void parseCXXMemberExpression(clang::CallExpr* callEpr);
 
@@ -116,6 +145,9 @@ private:
     // Supports C++ method, operator and method overloading and template class
     void StoreClassAndMethodInfo(clang::CXXMethodDecl* methodDecl, bool operatorOverloadingType = false);
 
+    // Read name, namespaces, template parameters and file of the class, Returns false when incomplete
+    bool readClassInfo(clang::CXXRecordDecl* recordDecl, ClassInfo& classInfo);
+
     // Parse parent information of the given declaration
     // Parent hierarchy information is fetched till certain level
     void processParentInfoOfDeclaration(clang::DeclContext* parentDeclContext, const std::string& inputChildInfo,
@@ -139,6 +171,10 @@ private:
     //             WorkAround: Include bits/stdc++.h to blindly include everything
     std::optional<std::string> getFileNameFromTypeDeclaration(clang::Type* type);
 
+    // Declaration tagged with the given type, Pointer and reference types are unwrapped once
+    // nullptr for build in types and types without declaration
+    clang::TagDecl* getTagDeclOfType(clang::Type* type);
+
     // Get parent information of clang::Type
     // Eample -> class Foo { class Bar {};};
     //        -> This function is used to retrieve Foo declaration from Type Bar 
@@ -161,10 +197,14 @@ private:
     // Workaround to find out c++ stds
     bool isStdNamespace(const std::string namespaceInfo);
 
-    // Determine whether to mock the given file or not
-    // Mock or not to Mock is decided based on the file
+    // Determine whether to mock the given declaration or not
+    // Mock or not to Mock is decided based on the file, Unless a symbol rule of the policy matches symbolName
     // Once file is choosen to not mock, Then content of that file will not be mocked in further findings
-    bool fileContentToBeMocked(const std::string& fileName, const std::string& className);
+    // The decision is kept in the classification, So each file is decided once
+    bool fileContentToBeMocked(FileClassification& file, const std::string& symbolName);
+
+    // Decide by the files confirmed so far and the path rules of the policy, Ask the user for new files
+    bool fileContentToBeMockedByName(const std::string& fileName, const std::string& symbolName);
 
     std::string getfileNameFromPath(const std::string& filePath);
 
@@ -173,10 +213,10 @@ private:
     std::string getTypeNameFromQualifiedTypeName(const std::string& qualifiedTypeName);
 
     // Store given variable information list into m_variableInfoContainerMap
-    void storeListInfoContainer(const std::string& fileName, const std::vector<std::string>& varInfoList);
+    void storeListInfoContainer(const std::string& fileName, const std::vector<InternedString>& varInfoList);
 
     // Implements core logic of storing variable information in m_variableInfoContainerMap
-    void storeListInfoContainerCore(const std::vector<std::string>& varInfoList, VariableInfoHierarchy& container, const bool newEntry = false);
+    void storeListInfoContainerCore(const std::vector<InternedString>& varInfoList, VariableInfoHierarchy& container, const bool newEntry = false);
 
     // To obtain file-related information(Example: filename, location) utilize Clang ASTContext and SourceManager
     clang::ASTContext& m_ASTContext;
@@ -201,14 +241,29 @@ private:
     // List of sequence of variable information corresponding to file
     std::map<std::string/*fileName*/, std::list<VariableInfoHierarchy>> m_variableInfoContainerMap;
 
+    // Classification of each file seen so far, Visitors decide with one lookup
+    llvm::DenseMap<clang::FileID, FileClassification> m_fileClassifications;
+    std::string m_mainFileName;
+
+    // Methods, Functions, Enum values and members already processed, Keyed by canonical declaration.
+    // Repeated uses of a declaration are skipped with one lookup
+    llvm::DenseSet<const clang::Decl*> m_visitedDecls;
+
+    // Class information of each class, Keyed by canonical declaration
+    llvm::DenseMap<const clang::CXXRecordDecl*, ClassInfo> m_recordClassInfo;
+
+    // Stored method signatures of each class and function names of each file
+    std::map<std::string/*qualified className*/, llvm::StringSet<>> m_classMethodSignatures;
+    std::map<std::string/*fileName*/, llvm::StringSet<>> m_cFunctionNames;
+
     MethodInfo calleeData = {};
-    std::vector<std::string> notTobeMockedFiles = {"include/c++/", "include/x86_64-linux-gnu/c++"};
-    std::vector<std::string> tobeMockedFiles = {};
+    // Answers of the user by file path, C++ std files are classified as FileKind::Std
+    std::map<std::string, bool> m_fileAnswers;
 
-    bool askUserConfirmation = true;
+    // Rules deciding instead of the user, Shared by all translation units
+    MockPolicy* m_mockPolicy = nullptr;
 
-    // Logger file
-    std::ofstream logFile;
+    bool askUserConfirmation = true;
 
 };
 
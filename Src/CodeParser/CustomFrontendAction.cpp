@@ -23,8 +23,23 @@
 
 #include "CustomFrontendAction.hpp"
 
+CustomFrontendAction::CustomFrontendAction(const ParserSettings& settings)
+    : m_settings(settings) {
+}
+
 // This function gets called automatically when parsing started
 // Callback function to get AST consumer
 std::unique_ptr<clang::ASTConsumer> CustomFrontendAction::CreateASTConsumer(clang::CompilerInstance &ci, clang::StringRef /*inFile*/) {
-    return std::make_unique<CustomASTConsumer>(ci.getSourceManager()); // supply custom consumer
+    // Parser asks the consumer for each function body whether it can be skipped, See CustomASTConsumer::shouldSkipFunctionBody
+    ci.getFrontendOpts().SkipFunctionBodies = m_settings.skipFunctionBodiesOutsideMainFile;
+    return std::make_unique<CustomASTConsumer>(ci.getSourceManager(), m_settings); // supply custom consumer
+}
+
+CustomFrontendActionFactory::CustomFrontendActionFactory(const ParserSettings& settings)
+    : m_settings(settings) {
+}
+
+// ClangTool takes the ownership of the returned action
+clang::FrontendAction* CustomFrontendActionFactory::create() {
+    return new CustomFrontendAction(m_settings);
 }
@@ -24,15 +24,18 @@
 
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Frontend/CompilerInstance.h"
+#include "clang/Tooling/Tooling.h"
 
 #include "CustomASTConsumer.hpp"
 #include "MockGeneratorTypes.hpp"
+#include "ParserSettings.hpp"
 
 
 class CustomFrontendAction : public clang::ASTFrontendAction {
 public:
 
     explicit CustomFrontendAction() = default;
+    explicit CustomFrontendAction(const ParserSettings& settings);
     ~CustomFrontendAction() = default;
 
     /** Create AST consumer
@@ -44,6 +47,21 @@ public:
 
 private:
     clang::SourceManager* m_sourceManager = nullptr;
+
+    ParserSettings m_settings = {};
+};
+
+// Factory used by ClangTool to create a CustomFrontendAction per translation unit with the given settings
+class CustomFrontendActionFactory : public clang::tooling::FrontendActionFactory {
+public:
+
+    explicit CustomFrontendActionFactory(const ParserSettings& settings);
+    ~CustomFrontendActionFactory() = default;
+
+    clang::FrontendAction* create() override;
+
+private:
+    ParserSettings m_settings;
 };
 
 #endif // CUSTOMFRONTENDACTION_HPP
@@ -35,7 +35,7 @@ public:
      * @param fileName: The mock file name
      * @param includes: List of include information
      */
-    virtual void constructIncludes(const std::string& fileName, const std::vector<std::string>& includes) = 0;
+    virtual void constructIncludes(const std::string& fileName, const std::vector<InternedString>& includes) = 0;
 
     /**
      * @brief Write enum information to mock file
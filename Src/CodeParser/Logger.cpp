@@ -0,0 +1,347 @@
+/**
+  * @file: Logger.cpp
+  * @brief: The Logger writes log records of all threads to one log file. Records below the compile-time or run-time
+  *         level are dropped before their message is formatted. Enabled records are put into a lock-free ring buffer
+  *         and written by a background thread, So logging never waits for the file
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "Logger.hpp"
+
+namespace {
+
+// Power of two, So a position maps to its slot by masking
+const uint64_t ringCapacity = 16384;
+
+// The writer sleeps this long when the ring buffer is empty
+const std::chrono::milliseconds writerInterval(10);
+
+// Producers wake the writer every this many records, Bursts would fill the ring buffer within one interval otherwise
+const uint64_t wakeUpDistance = ringCapacity / 4;
+
+const char* const levelNames[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+const char* const jsonLevelNames[] = {"debug", "info", "warn", "error"};
+
+// Slot of the ring buffer. The sequence tells who owns the slot:
+// sequence == position           - Free, A producer claiming position may fill it
+// sequence == position + 1       - Filled, The consumer may take it
+// sequence == position + capacity - Taken, Free again for the next round
+struct Record {
+    std::atomic<uint64_t> sequence = {0};
+    LogLevel level = LogLevel::Info;
+    uint64_t time = 0;
+    uint32_t process = 0;
+    uint64_t thread = 0;
+    std::string message;
+};
+
+// Bounded multi-producer single-consumer queue(Vyukov). Producers never lock, The consumer side is guarded by
+// consumerMutex so the writer thread and flush() never drain at the same time
+struct LoggerState {
+    LoggerState() {
+        for(uint64_t i = 0; i < ringCapacity; i++) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    Record ring[ringCapacity];
+    std::atomic<uint64_t> enqueuePosition = {0};
+    uint64_t dequeuePosition = 0;
+    std::atomic<uint64_t> dropped = {0};
+
+    std::mutex consumerMutex;
+    std::string fileName = "AutoDepMocker.log";
+    LogFormat format = LogFormat::Text;
+    int fd = -1;
+    std::string batch;
+
+    std::atomic<bool> writerStarted = {false};
+    std::atomic<bool> stopWriter = {false};
+    std::thread* writer = nullptr;
+    std::mutex wakeUpMutex;
+    std::condition_variable wakeUp;
+};
+
+// Never destroyed, Threads and atexit handlers may still log while static objects are destroyed
+LoggerState& getState() {
+    static LoggerState* state = new LoggerState();
+    return *state;
+}
+
+void appendJsonString(std::string& output, const std::string& value) {
+    output.push_back('"');
+    for(const char each : value) {
+        switch(each) {
+        case '"':
+            output.append("\\\"");
+            break;
+        case '\\':
+            output.append("\\\\");
+            break;
+        case '\n':
+            output.append("\\n");
+            break;
+        case '\r':
+            output.append("\\r");
+            break;
+        case '\t':
+            output.append("\\t");
+            break;
+        default:
+            if(static_cast<unsigned char>(each) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(each));
+                output.append(escaped);
+            } else {
+                output.push_back(each);
+            }
+        }
+    }
+    output.push_back('"');
+}
+
+template <typename T>
+void appendBinary(std::string& output, const T value) {
+    output.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void appendRecord(std::string& output, const LogFormat format, const Record& record) {
+    const std::size_t level = static_cast<std::size_t>(record.level);
+    switch(format) {
+    case LogFormat::Text:
+        output.append(levelNames[level]);
+        output.append(": ");
+        output.append(record.message);
+        output.push_back('\n');
+        break;
+    case LogFormat::JsonLines:
+        output.append("{\"time\":" + std::to_string(record.time));
+        output.append(",\"level\":\"" + std::string(jsonLevelNames[level]) + "\"");
+        output.append(",\"process\":" + std::to_string(record.process));
+        output.append(",\"thread\":" + std::to_string(record.thread));
+        output.append(",\"message\":");
+        appendJsonString(output, record.message);
+        output.append("}\n");
+        break;
+    case LogFormat::Binary:
+        appendBinary<uint8_t>(output, static_cast<uint8_t>(record.level));
+        appendBinary<uint64_t>(output, record.time);
+        appendBinary<uint32_t>(output, record.process);
+        appendBinary<uint64_t>(output, record.thread);
+        appendBinary<uint32_t>(output, static_cast<uint32_t>(record.message.size()));
+        output.append(record.message);
+        break;
+    }
+}
+
+void openLogFile(LoggerState& state, const bool truncate) {
+    // O_APPEND, So forked children sharing the descriptor never overwrite each other's records
+    state.fd = ::open(state.fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+}
+
+// Take all filled records and write them with one write call, Caller holds consumerMutex.
+// Returns false when the ring buffer was empty
+bool drain(LoggerState& state) {
+    while(true) {
+        Record& record = state.ring[state.dequeuePosition & (ringCapacity - 1)];
+        if(record.sequence.load(std::memory_order_acquire) != state.dequeuePosition + 1) {
+            break;
+        }
+        appendRecord(state.batch, state.format, record);
+        record.message.clear();
+        record.sequence.store(state.dequeuePosition + ringCapacity, std::memory_order_release);
+        ++state.dequeuePosition;
+    }
+    if(state.batch.empty()) {
+        return false;
+    }
+
+    if(state.fd < 0) {
+        openLogFile(state, false);
+    }
+    const char* data = state.batch.data();
+    std::size_t remaining = state.batch.size();
+    while((state.fd >= 0) && remaining) {
+        const ssize_t written = ::write(state.fd, data, remaining);
+        if(written < 0) {
+            if(EINTR == errno) {
+                continue;
+            }
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+    state.batch.clear();
+    return true;
+}
+
+void runWriter() {
+    LoggerState& state = getState();
+    while(! state.stopWriter.load(std::memory_order_acquire)) {
+        bool written = false;
+        {
+            std::lock_guard<std::mutex> lock(state.consumerMutex);
+            written = drain(state);
+        }
+        if(! written) {
+            // Wake-ups may be missed, The timeout bounds the delay then
+            std::unique_lock<std::mutex> lock(state.wakeUpMutex);
+            state.wakeUp.wait_for(lock, writerInterval);
+        }
+    }
+}
+
+void stopWriter() {
+    LoggerState& state = getState();
+    state.stopWriter.store(true, std::memory_order_release);
+    state.wakeUp.notify_one();
+    std::thread* writer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state.consumerMutex);
+        writer = state.writer;
+    }
+    if(writer && writer->joinable()) {
+        writer->join();
+    }
+    Logger::flush();
+}
+
+// A forked child only has the forking thread. Draining before the fork keeps records from being written twice,
+// The child starts its own writer with its first record. The writer may hold wakeUpMutex at any time, So it is
+// taken as well and the child never inherits it locked
+void prepareFork() {
+    LoggerState& state = getState();
+    state.consumerMutex.lock();
+    state.wakeUpMutex.lock();
+    drain(state);
+}
+
+void afterForkInParent() {
+    LoggerState& state = getState();
+    state.wakeUpMutex.unlock();
+    state.consumerMutex.unlock();
+}
+
+void afterForkInChild() {
+    LoggerState& state = getState();
+    state.writer = nullptr; // The thread does not exist in the child, Its object is leaked
+    state.writerStarted.store(false, std::memory_order_relaxed);
+
+    // Slots claimed by other threads of the parent are never filled in the child, drain() would stop at the first
+    // of them forever. Records behind it are written by the parent, So the ring starts empty again
+    for(uint64_t i = 0; i < ringCapacity; i++) {
+        state.ring[i].message.clear();
+        state.ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    state.enqueuePosition.store(0, std::memory_order_relaxed);
+    state.dequeuePosition = 0;
+
+    state.wakeUpMutex.unlock();
+    state.consumerMutex.unlock();
+}
+
+void startWriter(LoggerState& state) {
+    static std::once_flag registered;
+    std::call_once(registered, []() {
+        ::pthread_atfork(prepareFork, afterForkInParent, afterForkInChild);
+        std::atexit(stopWriter);
+    });
+    std::lock_guard<std::mutex> lock(state.consumerMutex);
+    state.writer = new std::thread(runWriter);
+}
+
+}
+
+std::atomic<uint8_t> Logger::s_level = {static_cast<uint8_t>(LogLevel::Warn)};
+
+void Logger::configure(const std::string& fileName, const LogLevel level, const LogFormat format,
+                       const bool truncate) {
+    LoggerState& state = getState();
+    {
+        std::lock_guard<std::mutex> lock(state.consumerMutex);
+        if(state.fd >= 0) {
+            ::close(state.fd);
+            state.fd = -1;
+        }
+        state.fileName = fileName;
+        state.format = format;
+        if(LogLevel::Off != level) {
+            openLogFile(state, truncate);
+        }
+    }
+    s_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+void Logger::write(const LogLevel level, std::string&& message) {
+    LoggerState& state = getState();
+    if(! state.writerStarted.exchange(true, std::memory_order_acq_rel)) {
+        startWriter(state);
+    }
+
+    uint64_t position = state.enqueuePosition.load(std::memory_order_relaxed);
+    Record* record = nullptr;
+    while(true) {
+        record = &state.ring[position & (ringCapacity - 1)];
+        const int64_t difference = static_cast<int64_t>(record->sequence.load(std::memory_order_acquire) - position);
+        if(0 == difference) {
+            if(state.enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if(difference < 0) {
+            // Full, The writer is behind. Dropping keeps the visitor from waiting for the disk
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = state.enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->level = level;
+    record->time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record->process = static_cast<uint32_t>(::getpid());
+    record->thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    record->message = std::move(message);
+    record->sequence.store(position + 1, std::memory_order_release);
+
+    if(0 == ((position + 1) % wakeUpDistance)) {
+        state.wakeUp.notify_one();
+    }
+}
+
+void Logger::flush() {
+    LoggerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.consumerMutex);
+    while(drain(state)) {
+    }
+}
+
+uint64_t Logger::getDroppedCount() {
+    return getState().dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,109 @@
+/**
+  * @file: Logger.hpp
+  * @brief: The Logger writes log records of all threads to one log file. Records below the compile-time or run-time
+  *         level are dropped before their message is formatted. Enabled records are put into a lock-free ring buffer
+  *         and written by a background thread, So logging never waits for the file
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Formats:
+// --------
+// Text       - "<LEVEL>: <message>\n", Like the log of earlier versions
+// JsonLines  - {"time":<ns since epoch>,"level":"<level>","process":<pid>,"thread":<id>,"message":"<message>"}\n
+// Binary     - Per record: level(uint8), time(uint64, ns since epoch), process(uint32), thread(uint64), length(uint32),
+//              message bytes. Numbers in host byte order
+//
+// Usage: LOG_INFO("Visiting " << name << ", kind: " << kind);
+// The streamed expression is only evaluated when the level is enabled.
+// Define AUTO_DEP_MOCKER_MINIMUM_LOG_LEVEL(0 - debug .. 4 - off) to remove lower levels at compile time
+//
+// When the ring buffer is full records are dropped instead of blocking, See getDroppedCount()
+
+#ifndef LOGGER_HPP_
+#define LOGGER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#ifndef AUTO_DEP_MOCKER_MINIMUM_LOG_LEVEL
+#define AUTO_DEP_MOCKER_MINIMUM_LOG_LEVEL 0
+#endif
+
+enum class LogLevel : uint8_t {
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+enum class LogFormat : uint8_t {
+    Text,
+    JsonLines,
+    Binary
+};
+
+class Logger {
+public:
+
+    /** Configure
+     * @brief: Call before the first record and before forking, The log file is opened here so forked children
+     *         append to the same file. Without configure() the defaults(AutoDepMocker.log, warn, text) are used and
+     *         the file is opened with the first record. Records are always appended, Processes writing the same log
+     *         (e.g. compiler processes loading the plugin) keep each other's records
+     * @arg fileName: Log file
+     * @arg level: Records below the level are dropped
+     * @arg format: Format of the records in the log file
+     * @arg truncate: Drop records of previous runs, Only for the driver which starts a new log
+     */
+    static void configure(const std::string& fileName, const LogLevel level, const LogFormat format,
+                          const bool truncate = false);
+
+    static bool isEnabled(const LogLevel level) {
+        return (level >= compiledLevel) && (static_cast<uint8_t>(level) >= s_level.load(std::memory_order_relaxed));
+    }
+
+    // Queue the record for the background writer, Never blocks
+    static void write(const LogLevel level, std::string&& message);
+
+    // Write all queued records in the calling thread(e.g. before _exit of a forked child)
+    static void flush();
+
+    // Records lost since the ring buffer was full
+    static uint64_t getDroppedCount();
+
+private:
+    static constexpr LogLevel compiledLevel = static_cast<LogLevel>(AUTO_DEP_MOCKER_MINIMUM_LOG_LEVEL);
+    static std::atomic<uint8_t> s_level;
+};
+
+#define LOG_AT_LEVEL(level, message)                        \
+    do {                                                    \
+        if(Logger::isEnabled(level)) {                      \
+            std::ostringstream logStream;                   \
+            logStream << message;                           \
+            Logger::write(level, logStream.str());          \
+        }                                                   \
+    } while(false)
+
+#define LOG_DEBUG(message) LOG_AT_LEVEL(LogLevel::Debug, message)
+#define LOG_INFO(message) LOG_AT_LEVEL(LogLevel::Info, message)
+#define LOG_WARN(message) LOG_AT_LEVEL(LogLevel::Warn, message)
+#define LOG_ERROR(message) LOG_AT_LEVEL(LogLevel::Error, message)
+
+#endif // LOGGER_HPP_
@@ -0,0 +1,65 @@
+/**
+  * @file: MockFileEmitter.cpp
+  * @brief: The MockFileEmitter hands over collected mock information to the mock class generator
+  *         in the order expected by the generators(includes, enums, classes, C functions and fields)
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <mutex>
+
+#include "MockFileEmitter.hpp"
+#include "GMockClassGenerator.hpp"
+
+void MockFileEmitter::emit(const MockModel& model) {
+    GMockClassGenerator gmockGenerator;
+    emit(model, gmockGenerator);
+}
+
+void MockFileEmitter::emit(const MockModel& model, IMockGenerator& mockGenerator) {
+
+    // Generators append to the files of ./GeneratedMocks directory,
+    // So models have to be written one after another
+    static std::mutex generatorMutex;
+    std::lock_guard<std::mutex> lock(generatorMutex);
+
+    // Write include information first
+    for(const auto& each : model.includes) {
+        mockGenerator.constructIncludes(each.first, each.second);
+    }
+
+    // Write Enums
+    for(const auto& itr : model.enumInfo) {
+        mockGenerator.constructEnum(itr.first, itr.second);
+    }
+
+    // Write C++ classes
+    for(const auto& itr : model.classInfo) {
+        mockGenerator.constructClass(itr.second, model.classMethodInfo.at(itr.first));
+    }
+
+    // Write C functions
+    for(const auto& each : model.cFunctionInfo) {
+        mockGenerator.constructCFunction(each.first, each.second);
+    }
+
+    // Write field declaration
+    for(const auto& each : model.variableInfo) {
+        mockGenerator.constructFieldDeclation(each.first, each.second);
+    }
+
+    // Finish mocking
+    mockGenerator.finalizeMocking();
+}
@@ -0,0 +1,48 @@
+/**
+  * @file: MockFileEmitter.hpp
+  * @brief: The MockFileEmitter hands over collected mock information to the mock class generator
+  *         in the order expected by the generators(includes, enums, classes, C functions and fields)
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef MOCK_FILE_EMITTER_HPP_
+#define MOCK_FILE_EMITTER_HPP_
+
+#include "IMockGenerator.hpp"
+#include "MockGeneratorTypes.hpp"
+
+class MockFileEmitter {
+public:
+    explicit MockFileEmitter() = default;
+    ~MockFileEmitter() = default;
+    MockFileEmitter& operator =(const MockFileEmitter&) = delete;
+    MockFileEmitter(const MockFileEmitter&) = delete;
+
+    /** Emit mock files
+     * @brief: Write mock files of the given model to ./GeneratedMocks directory using GMockClassGenerator
+     * @arg model: Mock information of one or more translation units
+     */
+    void emit(const MockModel& model);
+
+    /** Emit mock files
+     * @brief: Write mock files of the given model using the given generator
+     * @arg model: Mock information of one or more translation units
+     * @arg mockGenerator: Generator to be used
+     */
+    void emit(const MockModel& model, IMockGenerator& mockGenerator);
+};
+
+#endif // MOCK_FILE_EMITTER_HPP_
@@ -24,46 +24,56 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <list>
 #include <cstdint>
 
 #include "clang/Basic/SourceManager.h"
 #include "clang/AST/ASTContext.h"
 
+#include "StringPool.hpp"
+
+// Type names, identifiers and file names are repeated across the model, So members are InternedStrings.
+// Keys of the maps are still plain strings, They are unique per map and the generators write files in the order of
+// the keys. Lookups and merges by key compare string contents, Only the members are compared by handle
+
 // Contains includes information mapped with file name
-using IncludeInfo = std::map<std::string, std::vector<std::string>>;
+using IncludeInfo = std::map<std::string, std::vector<InternedString>>;
 
 // Contains mock method(C and C++) information
 struct MethodInfo {
-    std::string name;
-    std::string returnType;
+    InternedString name;
+    InternedString returnType;
     bool isConst = false;
     bool isOperatorOverloading = false;
     bool isTemplated = false;
-    std::vector<std::string> args;
+    std::vector<InternedString> args;
 };
 
+// Default of ClassInfo::declKindName, Constructing a ClassInfo does not lock the string pool
+inline const InternedConstant classDeclKindName("class ");
+
 // Contains mock class information
 struct ClassInfo {
-    std::string name;
-    std::string fullName;
-    std::string declKindName = "class ";
-    std::string filename;
-    std::vector<std::string> namespaceInfo;
+    InternedString name;
+    InternedString fullName;
+    InternedString declKindName = classDeclKindName;
+    InternedString filename;
+    std::vector<InternedString> namespaceInfo;
     bool isTemplateClass = false;
-    std::vector<std::string> templateParams;
+    std::vector<InternedString> templateParams;
 };
 
-using ClassInfoType = std::map<std::string, ClassInfo>; // contains className and details about the class
-using ClassMethodInfoType = std::map<std::string, std::vector<MethodInfo>>; // contains className with methods info
+using ClassInfoType = std::map<std::string, ClassInfo>; // contains qualified className and details about the class
+using ClassMethodInfoType = std::map<std::string, std::vector<MethodInfo>>; // contains qualified className with methods info
 
 // C functions - store function and filename, filename is key
 using CFunctionInfoType = std::map<std::string, std::vector<MethodInfo>>;
 
 // C and CPP Enum information
 struct enumProperties {
-    std::string enumName; // Unique
-    std::string enumFullName; // with namespace
-    std::vector<std::string> enumValues;
+    InternedString enumName; // Unique
+    InternedString enumFullName; // with namespace
+    std::vector<InternedString> enumValues;
     bool isScopedEnum = false;
 };
 
@@ -71,8 +81,20 @@ using EnumInfo = std::map<std::string/*fileName*/, std::vector<enumProperties>>;
 
 // Contains chain of variable information
 struct VariableInfoHierarchy {
-    std::string variableInfo = {};
+    InternedString variableInfo = {};
     std::list<VariableInfoHierarchy> variableInfoHierarchyList = {};
 };
 
+using VariableInfoType = std::map<std::string/*fileName*/, std::list<VariableInfoHierarchy>>;
+
+// Complete mock information collected from one or more translation units
+struct MockModel {
+    IncludeInfo includes;
+    ClassInfoType classInfo;
+    ClassMethodInfoType classMethodInfo;
+    CFunctionInfoType cFunctionInfo;
+    EnumInfo enumInfo;
+    VariableInfoType variableInfo;
+};
+
 #endif // CUSTOM_TYPES_HPP_
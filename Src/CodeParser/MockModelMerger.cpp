@@ -0,0 +1,161 @@
+/**
+  * @file: MockModelMerger.cpp
+  * @brief: The MockModelMerger combines mock information of several translation units into one model with union semantics.
+  *         Methods are merged by signature, enumerators by value and field hierarchies by path
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <set>
+
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+
+#include "MockModelMerger.hpp"
+
+void MockModelMerger::merge(MockModel& target, MockModel&& source) {
+
+    // Includes - Keep the order of first appearance
+    for(auto& each : source.includes) {
+        std::vector<InternedString>& targetIncludes = target.includes[each.first];
+        for(auto& include : each.second) {
+            if(targetIncludes.end() == std::find(targetIncludes.begin(), targetIncludes.end(), include)) {
+                targetIncludes.push_back(std::move(include));
+            }
+        }
+    }
+
+    // C++ classes - Class information is the same in every translation unit, Only methods differ
+    for(auto& each : source.classInfo) {
+        target.classInfo.emplace(each.first, std::move(each.second));
+    }
+    for(auto& each : source.classMethodInfo) {
+        mergeMethods(target.classMethodInfo[each.first], std::move(each.second));
+    }
+
+    // C functions
+    for(auto& each : source.cFunctionInfo) {
+        mergeMethods(target.cFunctionInfo[each.first], std::move(each.second));
+    }
+
+    // C and C++ enums
+    for(auto& each : source.enumInfo) {
+        mergeEnums(target.enumInfo[each.first], std::move(each.second));
+    }
+
+    // Field declarations
+    for(auto& each : source.variableInfo) {
+        mergeVariableHierarchy(target.variableInfo[each.first], std::move(each.second));
+    }
+}
+
+MockModel MockModelMerger::mergeAll(std::vector<MockModel>&& models, const unsigned jobs) {
+    if(models.empty()) {
+        return {};
+    }
+
+    // Tree reduction: model[i] += model[i + stride] for every i multiple of (2 * stride)
+    // Each task of a round works on its own pair of models
+    llvm::ThreadPool pool(jobs ? jobs : llvm::hardware_concurrency());
+    for(std::size_t stride = 1; stride < models.size(); stride *= 2) {
+        for(std::size_t i = 0; (i + stride) < models.size(); i += (2 * stride)) {
+            pool.async([&models, i, stride]() {
+                MockModelMerger merger;
+                merger.merge(models[i], std::move(models[i + stride]));
+            });
+        }
+        pool.wait(); // Round completed
+    }
+
+    return std::move(models.front());
+}
+
+// Example: foo(int, const char *) const
+std::string MockModelMerger::getMethodSignature(const MethodInfo& methodInfo) {
+    std::string signature = methodInfo.name.str() + "(";
+    for(std::size_t i = 0; i < methodInfo.args.size(); i++) {
+        if(i) {
+            signature.append(", ");
+        }
+        signature.append(methodInfo.args[i]);
+    }
+    signature.append(")");
+    if(methodInfo.isConst) {
+        signature.append(" const");
+    }
+    return signature;
+}
+
+void MockModelMerger::mergeMethods(std::vector<MethodInfo>& target, std::vector<MethodInfo>&& source) {
+    std::set<std::vector<uint32_t>> knownSignatures;
+    for(const auto& each : target) {
+        knownSignatures.insert(getSignatureKey(each));
+    }
+
+    for(auto& each : source) {
+        if(knownSignatures.insert(getSignatureKey(each)).second) {
+            target.push_back(std::move(each));
+        }
+    }
+}
+
+// Equal strings have equal handles, So no signature string has to be built
+std::vector<uint32_t> MockModelMerger::getSignatureKey(const MethodInfo& methodInfo) {
+    std::vector<uint32_t> key;
+    key.reserve(methodInfo.args.size() + 2);
+    key.push_back(methodInfo.name.getHandle());
+    key.push_back(methodInfo.isConst);
+    for(const auto& each : methodInfo.args) {
+        key.push_back(each.getHandle());
+    }
+    return key;
+}
+
+void MockModelMerger::mergeEnums(std::vector<enumProperties>& target, std::vector<enumProperties>&& source) {
+    for(auto& sourceEnum : source) {
+        auto targetEnum = std::find_if(target.begin(), target.end(), [&sourceEnum](const enumProperties& each) {
+            return each.enumName == sourceEnum.enumName;
+        });
+
+        if(target.end() == targetEnum) {
+            target.push_back(std::move(sourceEnum));
+            continue;
+        }
+
+        // Enum is known, Add missing enumerators
+        for(auto& value : sourceEnum.enumValues) {
+            if(targetEnum->enumValues.end() == std::find(targetEnum->enumValues.begin(), targetEnum->enumValues.end(), value)) {
+                targetEnum->enumValues.push_back(std::move(value));
+            }
+        }
+    }
+}
+
+void MockModelMerger::mergeVariableHierarchy(std::list<VariableInfoHierarchy>& target, std::list<VariableInfoHierarchy>&& source) {
+    for(auto& sourceNode : source) {
+        auto targetNode = std::find_if(target.begin(), target.end(), [&sourceNode](const VariableInfoHierarchy& each) {
+            return each.variableInfo == sourceNode.variableInfo;
+        });
+
+        if(target.end() == targetNode) {
+            target.push_back(std::move(sourceNode));
+            continue;
+        }
+
+        // Same path exists, Continue with the children
+        mergeVariableHierarchy(targetNode->variableInfoHierarchyList, std::move(sourceNode.variableInfoHierarchyList));
+    }
+}
@@ -0,0 +1,73 @@
+/**
+  * @file: MockModelMerger.hpp
+  * @brief: The MockModelMerger combines mock information of several translation units into one model with union semantics.
+  *         Methods are merged by signature, enumerators by value and field hierarchies by path
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef MOCK_MODEL_MERGER_HPP_
+#define MOCK_MODEL_MERGER_HPP_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "MockGeneratorTypes.hpp"
+
+class MockModelMerger {
+public:
+    explicit MockModelMerger() = default;
+    ~MockModelMerger() = default;
+    MockModelMerger& operator =(const MockModelMerger&) = delete;
+    MockModelMerger(const MockModelMerger&) = delete;
+
+    /** Merge
+     * @brief: Merge source model into target model. Entries already present in target are kept as they are
+     * @arg target: Model which receives the union
+     * @arg source: Model to be merged, Content is moved out
+     */
+    void merge(MockModel& target, MockModel&& source);
+
+    /** Merge all
+     * @brief: Merge all given models into one. Models are merged pairwise in parallel(tree reduction),
+     *         Each merge step owns two distinct models so no locking is required.
+     *         Merge order only depends on the position of the models, So the result is deterministic
+     * @arg models: Models of each translation unit
+     * @arg jobs: Number of worker threads, 0 means one worker per hardware thread
+     * @return MockModel: Combined model
+     */
+    MockModel mergeAll(std::vector<MockModel>&& models, const unsigned jobs = 0);
+
+    // Signature of a method used as merge key
+    // Example: foo(int, const char *) const
+    static std::string getMethodSignature(const MethodInfo& methodInfo);
+
+    // Handles of name, constness and arguments, Equal for methods with equal getMethodSignature()
+    static std::vector<uint32_t> getSignatureKey(const MethodInfo& methodInfo);
+
+private:
+    // Union of methods by signature
+    void mergeMethods(std::vector<MethodInfo>& target, std::vector<MethodInfo>&& source);
+
+    // Union of enumerators by value
+    void mergeEnums(std::vector<enumProperties>& target, std::vector<enumProperties>&& source);
+
+    // Union of field hierarchies by path
+    void mergeVariableHierarchy(std::list<VariableInfoHierarchy>& target, std::list<VariableInfoHierarchy>&& source);
+};
+
+#endif // MOCK_MODEL_MERGER_HPP_
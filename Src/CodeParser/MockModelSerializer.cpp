@@ -0,0 +1,353 @@
+/**
+  * @file: MockModelSerializer.cpp
+  * @brief: The MockModelSerializer converts a MockModel to a byte string and back.
+  *         Used to store the mock information of translation units on disk(result cache, shards)
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "MockModelSerializer.hpp"
+
+namespace {
+
+// 3 - Classes are keyed by qualified name
+const char* const formatHeader = "AutoDepMockerModel 3\n";
+
+class ModelWriter {
+public:
+    void number(const std::size_t value) {
+        m_data.append(std::to_string(value));
+        m_data.push_back(' ');
+    }
+
+    void string(const std::string& value) {
+        m_data.append(std::to_string(value.size()));
+        m_data.push_back(':');
+        m_data.append(value);
+        m_data.push_back(' ');
+    }
+
+    // Index into the string table, Each string is written once per model
+    void interned(const InternedString& value) {
+        const auto inserted = m_tableIndices.insert({value.getHandle(), m_table.size()});
+        if(inserted.second) {
+            m_table.push_back(value);
+        }
+        number(inserted.first->second);
+    }
+
+    void interned(const std::vector<InternedString>& values) {
+        number(values.size());
+        for(const auto& each : values) {
+            interned(each);
+        }
+    }
+
+    void method(const MethodInfo& methodInfo) {
+        interned(methodInfo.name);
+        interned(methodInfo.returnType);
+        number(methodInfo.isConst);
+        number(methodInfo.isOperatorOverloading);
+        number(methodInfo.isTemplated);
+        interned(methodInfo.args);
+    }
+
+    void methods(const std::map<std::string, std::vector<MethodInfo>>& methodMap) {
+        number(methodMap.size());
+        for(const auto& each : methodMap) {
+            string(each.first);
+            number(each.second.size());
+            for(const auto& methodInfo : each.second) {
+                method(methodInfo);
+            }
+        }
+    }
+
+    void variableHierarchy(const std::list<VariableInfoHierarchy>& hierarchyList) {
+        number(hierarchyList.size());
+        for(const auto& each : hierarchyList) {
+            interned(each.variableInfo);
+            variableHierarchy(each.variableInfoHierarchyList);
+        }
+    }
+
+    // Header, string table and the members written so far
+    std::string finish() {
+        ModelWriter table;
+        table.m_data.append(formatHeader);
+        table.number(m_table.size());
+        for(const auto& each : m_table) {
+            table.string(each);
+        }
+        table.m_data.append(m_data);
+        return std::move(table.m_data);
+    }
+
+private:
+    std::string m_data;
+    std::vector<InternedString> m_table;
+    llvm::DenseMap<uint32_t, std::size_t> m_tableIndices;
+};
+
+class ModelReader {
+public:
+    explicit ModelReader(llvm::StringRef data)
+        : m_data(data) {
+    }
+
+    bool number(std::size_t& value) {
+        const std::size_t end = m_data.find(' ');
+        if((llvm::StringRef::npos == end) || m_data.substr(0, end).getAsInteger(10, value)) {
+            return false;
+        }
+        m_data = m_data.drop_front(end + 1);
+        return true;
+    }
+
+    // Element count of a container, Each element takes at least one byte so larger counts are corrupted data
+    bool size(std::size_t& value) {
+        return number(value) && (value <= m_data.size());
+    }
+
+    bool flag(bool& value) {
+        std::size_t number = 0;
+        if(! this->number(number) || (number > 1)) {
+            return false;
+        }
+        value = (1 == number);
+        return true;
+    }
+
+    bool string(std::string& value) {
+        const std::size_t separator = m_data.find(':');
+        std::size_t length = 0;
+        if((llvm::StringRef::npos == separator) || m_data.substr(0, separator).getAsInteger(10, length) ||
+           (m_data.size() < separator + length + 2) || (' ' != m_data[separator + 1 + length])) {
+            return false;
+        }
+        value = m_data.substr(separator + 1, length).str();
+        m_data = m_data.drop_front(separator + length + 2);
+        return true;
+    }
+
+    // Strings are interned once, Members refer to them by index
+    bool table() {
+        std::size_t count = 0;
+        if(! size(count)) {
+            return false;
+        }
+        m_table.resize(count);
+        for(auto& each : m_table) {
+            std::string value;
+            if(! string(value)) {
+                return false;
+            }
+            each = value;
+        }
+        return true;
+    }
+
+    bool interned(InternedString& value) {
+        std::size_t index = 0;
+        if(! number(index) || (index >= m_table.size())) {
+            return false;
+        }
+        value = m_table[index];
+        return true;
+    }
+
+    bool interned(std::vector<InternedString>& values) {
+        std::size_t count = 0;
+        if(! size(count)) {
+            return false;
+        }
+        values.resize(count);
+        for(auto& each : values) {
+            if(! interned(each)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool method(MethodInfo& methodInfo) {
+        return interned(methodInfo.name) && interned(methodInfo.returnType) && flag(methodInfo.isConst) &&
+               flag(methodInfo.isOperatorOverloading) && flag(methodInfo.isTemplated) && interned(methodInfo.args);
+    }
+
+    bool methods(std::map<std::string, std::vector<MethodInfo>>& methodMap) {
+        std::size_t count = 0;
+        if(! size(count)) {
+            return false;
+        }
+        for(std::size_t i = 0; i < count; i++) {
+            std::string key;
+            std::size_t methodCount = 0;
+            if(! string(key) || ! size(methodCount)) {
+                return false;
+            }
+            std::vector<MethodInfo>& methodList = methodMap[key];
+            methodList.resize(methodCount);
+            for(auto& each : methodList) {
+                if(! method(each)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool variableHierarchy(std::list<VariableInfoHierarchy>& hierarchyList) {
+        std::size_t count = 0;
+        if(! size(count)) {
+            return false;
+        }
+        for(std::size_t i = 0; i < count; i++) {
+            hierarchyList.emplace_back();
+            if(! interned(hierarchyList.back().variableInfo) ||
+               ! variableHierarchy(hierarchyList.back().variableInfoHierarchyList)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool atEnd() const {
+        return m_data.empty();
+    }
+
+private:
+    llvm::StringRef m_data;
+    std::vector<InternedString> m_table;
+};
+
+}
+
+std::string MockModelSerializer::serialize(const MockModel& model) {
+    ModelWriter writer;
+
+    writer.number(model.includes.size());
+    for(const auto& each : model.includes) {
+        writer.string(each.first);
+        writer.interned(each.second);
+    }
+
+    writer.number(model.classInfo.size());
+    for(const auto& each : model.classInfo) {
+        writer.string(each.first);
+        writer.interned(each.second.name);
+        writer.interned(each.second.fullName);
+        writer.interned(each.second.declKindName);
+        writer.interned(each.second.filename);
+        writer.interned(each.second.namespaceInfo);
+        writer.number(each.second.isTemplateClass);
+        writer.interned(each.second.templateParams);
+    }
+
+    writer.methods(model.classMethodInfo);
+    writer.methods(model.cFunctionInfo);
+
+    writer.number(model.enumInfo.size());
+    for(const auto& each : model.enumInfo) {
+        writer.string(each.first);
+        writer.number(each.second.size());
+        for(const auto& enumInfo : each.second) {
+            writer.interned(enumInfo.enumName);
+            writer.interned(enumInfo.enumFullName);
+            writer.interned(enumInfo.enumValues);
+            writer.number(enumInfo.isScopedEnum);
+        }
+    }
+
+    writer.number(model.variableInfo.size());
+    for(const auto& each : model.variableInfo) {
+        writer.string(each.first);
+        writer.variableHierarchy(each.second);
+    }
+
+    return writer.finish();
+}
+
+bool MockModelSerializer::deserialize(llvm::StringRef data, MockModel& model) {
+    if(! data.consume_front(formatHeader)) {
+        return false;
+    }
+    ModelReader reader(data);
+    std::size_t count = 0;
+
+    if(! reader.table() || ! reader.size(count)) {
+        return false;
+    }
+    for(std::size_t i = 0; i < count; i++) {
+        std::string key;
+        if(! reader.string(key) || ! reader.interned(model.includes[key])) {
+            return false;
+        }
+    }
+
+    if(! reader.size(count)) {
+        return false;
+    }
+    for(std::size_t i = 0; i < count; i++) {
+        std::string key;
+        if(! reader.string(key)) {
+            return false;
+        }
+        ClassInfo& classInfo = model.classInfo[key];
+        if(! reader.interned(classInfo.name) || ! reader.interned(classInfo.fullName) ||
+           ! reader.interned(classInfo.declKindName) || ! reader.interned(classInfo.filename) ||
+           ! reader.interned(classInfo.namespaceInfo) || ! reader.flag(classInfo.isTemplateClass) ||
+           ! reader.interned(classInfo.templateParams)) {
+            return false;
+        }
+    }
+
+    if(! reader.methods(model.classMethodInfo) || ! reader.methods(model.cFunctionInfo)) {
+        return false;
+    }
+
+    if(! reader.size(count)) {
+        return false;
+    }
+    for(std::size_t i = 0; i < count; i++) {
+        std::string key;
+        std::size_t enumCount = 0;
+        if(! reader.string(key) || ! reader.size(enumCount)) {
+            return false;
+        }
+        std::vector<enumProperties>& enumList = model.enumInfo[key];
+        enumList.resize(enumCount);
+        for(auto& each : enumList) {
+            if(! reader.interned(each.enumName) || ! reader.interned(each.enumFullName) ||
+               ! reader.interned(each.enumValues) || ! reader.flag(each.isScopedEnum)) {
+                return false;
+            }
+        }
+    }
+
+    if(! reader.size(count)) {
+        return false;
+    }
+    for(std::size_t i = 0; i < count; i++) {
+        std::string key;
+        if(! reader.string(key) || ! reader.variableHierarchy(model.variableInfo[key])) {
+            return false;
+        }
+    }
+
+    return reader.atEnd();
+}
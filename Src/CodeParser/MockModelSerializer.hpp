@@ -0,0 +1,56 @@
+/**
+  * @file: MockModelSerializer.hpp
+  * @brief: The MockModelSerializer converts a MockModel to a byte string and back.
+  *         Used to store the mock information of translation units on disk(result cache, shards)
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Format:
+// -------
+// Header "AutoDepMockerModel <version>\n", string table, then the members of MockModel in declaration order.
+// Numbers are written as "<decimal> ", Strings as "<length>:<bytes> ", Containers as element count followed by elements.
+// The string table lists every distinct InternedString of the model once in order of first use,
+// InternedString members are written as their index into the table. Map keys are written as strings.
+// Maps are written in key order, So equal models always give equal bytes
+
+#ifndef MOCK_MODEL_SERIALIZER_HPP_
+#define MOCK_MODEL_SERIALIZER_HPP_
+
+#include <string>
+
+#include "llvm/ADT/StringRef.h"
+
+#include "MockGeneratorTypes.hpp"
+
+class MockModelSerializer {
+public:
+    explicit MockModelSerializer() = default;
+    ~MockModelSerializer() = default;
+    MockModelSerializer& operator =(const MockModelSerializer&) = delete;
+    MockModelSerializer(const MockModelSerializer&) = delete;
+
+    // Serialize the model, Deterministic for equal models
+    std::string serialize(const MockModel& model);
+
+    /** Deserialize
+     * @arg data: Output of serialize()
+     * @arg model: Receives the model, Left in an unspecified state on failure
+     * @return bool: false when data is truncated, corrupted or written by another format version
+     */
+    bool deserialize(llvm::StringRef data, MockModel& model);
+};
+
+#endif // MOCK_MODEL_SERIALIZER_HPP_
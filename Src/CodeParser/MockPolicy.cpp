@@ -0,0 +1,194 @@
+/**
+  * @file: MockPolicy.cpp
+  * @brief: The MockPolicy decides which declarations are mocked by rules on file paths and qualified symbol names
+  *         read from a policy file. Rules are compiled into one automaton per kind, So a decision takes a single
+  *         pass over the path or name regardless of the number of rules
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <fstream>
+#include <queue>
+#include <tuple>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "MockPolicy.hpp"
+
+namespace {
+
+// Anchors are matched as bytes which do not occur in paths and names
+const unsigned char textStart = '\x02';
+const unsigned char textEnd = '\x03';
+
+}
+
+bool MockPolicy::load(const std::string& policyFile, const bool recordAnswers, std::string& errorMessage) {
+    m_policyFile = policyFile;
+    m_recordAnswers = recordAnswers;
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(policyFile);
+    if(! buffer && ! (recordAnswers && ! llvm::sys::fs::exists(policyFile))) {
+        errorMessage = "Unable to read mock policy " + policyFile;
+        return false;
+    }
+
+    llvm::SmallVector<llvm::StringRef, 256> lines;
+    if(buffer) {
+        (*buffer)->getBuffer().split(lines, '\n');
+    }
+    for(std::size_t i = 0; i < lines.size(); i++) {
+        const llvm::StringRef line = lines[i].trim();
+        if(line.empty() || line.startswith("#")) {
+            continue;
+        }
+
+        llvm::StringRef action, kind, text;
+        std::tie(action, text) = line.split(' ');
+        std::tie(kind, text) = text.ltrim().split(' ');
+        text = text.trim();
+        const bool allow = ("allow" == action);
+        const bool pathRule = ("path" == kind);
+        if((! allow && ("deny" != action)) || (! pathRule && ("symbol" != kind)) || text.empty()) {
+            errorMessage = policyFile + ":" + std::to_string(i + 1) + ": Expected \"allow|deny path|symbol <text>\"";
+            return false;
+        }
+
+        (pathRule ? m_pathRules : m_symbolRules).addPattern(text, allow ? Decision::Mock : Decision::Skip);
+        m_rules.append(action.str() + " " + kind.str() + " " + text.str() + "\n");
+    }
+
+    m_pathRules.build();
+    m_symbolRules.build();
+    return true;
+}
+
+bool MockPolicy::save() const {
+    std::lock_guard<std::mutex> lock(m_answerMutex);
+    if(m_answers.empty()) {
+        return true;
+    }
+
+    std::ofstream policyFile(m_policyFile, std::ofstream::out | std::ofstream::app);
+    for(const auto& each : m_answers) {
+        policyFile << each << "\n";
+    }
+    return policyFile.good();
+}
+
+MockPolicy::Decision MockPolicy::decidePath(llvm::StringRef path) const {
+    return m_pathRules.match(path);
+}
+
+MockPolicy::Decision MockPolicy::decideSymbol(llvm::StringRef qualifiedName) const {
+    return m_symbolRules.match(qualifiedName);
+}
+
+void MockPolicy::recordAnswer(llvm::StringRef path, const bool mock) {
+    std::lock_guard<std::mutex> lock(m_answerMutex);
+    m_answers.push_back((mock ? "allow path ^" : "deny path ^") + path.str() + "$");
+}
+
+void MockPolicy::Automaton::addPattern(llvm::StringRef pattern, const Decision decision) {
+    llvm::SmallVector<unsigned char, 256> bytes;
+    if(pattern.consume_front("^")) {
+        bytes.push_back(textStart);
+    }
+    const bool anchoredEnd = pattern.consume_back("$");
+    bytes.append(pattern.bytes_begin(), pattern.bytes_end());
+    if(anchoredEnd) {
+        bytes.push_back(textEnd);
+    }
+
+    uint32_t state = 0;
+    for(const unsigned char byte : bytes) {
+        const auto inserted = m_transitions.insert({getTransitionKey(state, byte), uint32_t(m_states.size())});
+        if(inserted.second) {
+            m_states[state].children.push_back({byte, uint32_t(m_states.size())});
+            m_states.emplace_back();
+        }
+        state = inserted.first->second;
+    }
+
+    // Same text allowed and denied, Deny wins
+    State& terminal = m_states[state];
+    terminal.length = uint32_t(bytes.size());
+    if(Decision::Skip != terminal.decision) {
+        terminal.decision = decision;
+    }
+}
+
+void MockPolicy::Automaton::build() {
+    // Breadth first, So failure targets(shorter suffixes) are complete before their users
+    std::queue<uint32_t> pending;
+    for(const auto& each : m_states.front().children) {
+        pending.push(each.second);
+    }
+    while(! pending.empty()) {
+        const uint32_t state = pending.front();
+        pending.pop();
+        for(const auto& each : m_states[state].children) {
+            State& child = m_states[each.second];
+            child.failure = next(m_states[state].failure, each.first);
+
+            // The own pattern is longer than any pattern ending in the failure state
+            if(Decision::None == child.decision) {
+                child.decision = m_states[child.failure].decision;
+                child.length = m_states[child.failure].length;
+            }
+            pending.push(each.second);
+        }
+    }
+}
+
+MockPolicy::Decision MockPolicy::Automaton::match(llvm::StringRef text) const {
+    if(1 == m_states.size()) {
+        return Decision::None;
+    }
+
+    Decision decision = Decision::None;
+    uint32_t length = 0;
+    uint32_t state = 0;
+    const auto step = [this, &decision, &length, &state](const unsigned char byte) {
+        state = next(state, byte);
+        const State& current = m_states[state];
+        if((current.length > length) || ((current.length == length) && (Decision::Skip == current.decision))) {
+            decision = current.decision;
+            length = current.length;
+        }
+    };
+
+    step(textStart);
+    for(const unsigned char byte : text.bytes()) {
+        step(byte);
+    }
+    step(textEnd);
+    return decision;
+}
+
+uint32_t MockPolicy::Automaton::next(uint32_t state, const unsigned char byte) const {
+    while(true) {
+        const auto transition = m_transitions.find(getTransitionKey(state, byte));
+        if(m_transitions.end() != transition) {
+            return transition->second;
+        }
+        if(0 == state) {
+            return 0;
+        }
+        state = m_states[state].failure;
+    }
+}
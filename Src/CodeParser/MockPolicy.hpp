@@ -0,0 +1,130 @@
+/**
+  * @file: MockPolicy.hpp
+  * @brief: The MockPolicy decides which declarations are mocked by rules on file paths and qualified symbol names
+  *         read from a policy file. Rules are compiled into one automaton per kind, So a decision takes a single
+  *         pass over the path or name regardless of the number of rules
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Format:
+// -------
+// One rule per line, Empty lines and lines starting with '#' are ignored
+// allow path <text>    - Mock declarations of files whose path contains text
+// deny path <text>     - Do not mock declarations of files whose path contains text
+// allow symbol <text>  - Mock declarations whose qualified name(e.g. ns::Foo::bar) contains text
+// deny symbol <text>   - Do not mock declarations whose qualified name contains text
+//
+// Text starting with '^' must match at the start, Text ending with '$' at the end(e.g. "deny symbol ^std::").
+// Symbol rules take precedence over path rules. Among matching rules of a kind the longest text decides,
+// On equal length deny wins. Declarations no rule matches are asked in interactive mode and mocked otherwise
+
+#ifndef MOCK_POLICY_HPP_
+#define MOCK_POLICY_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+
+class MockPolicy {
+public:
+
+    enum class Decision : uint8_t {
+        None, // No rule matches
+        Mock,
+        Skip
+    };
+
+    explicit MockPolicy() = default;
+    ~MockPolicy() = default;
+    MockPolicy& operator =(const MockPolicy&) = delete;
+    MockPolicy(const MockPolicy&) = delete;
+
+    /** Load
+     * @brief: Read and compile the rules of the policy file
+     * @arg policyFile: Policy file, A missing file gives an empty policy when answers are recorded
+     * @arg recordAnswers: Answers of the user are appended to the policy file by save()
+     * @arg errorMessage: Receives the reason of a failure
+     * @return bool: false when the file can not be read or contains an invalid rule
+     */
+    bool load(const std::string& policyFile, const bool recordAnswers, std::string& errorMessage);
+
+    // Append the recorded answers to the policy file as path rules, Returns false on failure
+    bool save() const;
+
+    // Decision of the rules on the absolute file path, Thread-safe
+    Decision decidePath(llvm::StringRef path) const;
+
+    // Decision of the rules on the qualified name of the declaration, Thread-safe
+    Decision decideSymbol(llvm::StringRef qualifiedName) const;
+
+    // Answers of the user shall be recorded
+    bool isRecording() const {
+        return m_recordAnswers;
+    }
+
+    // Record the answer of the user for the file, Thread-safe
+    void recordAnswer(llvm::StringRef path, const bool mock);
+
+    // Rules in a normalized form, Results collected under different rules must not be mixed(e.g. result cache)
+    const std::string& getRules() const {
+        return m_rules;
+    }
+
+private:
+    // Aho-Corasick automaton of the rule texts of one kind
+    class Automaton {
+    public:
+        void addPattern(llvm::StringRef pattern, const Decision decision);
+
+        // Compute failure links and the decision of each state, Call once all patterns are added
+        void build();
+
+        Decision match(llvm::StringRef text) const;
+
+    private:
+        struct State {
+            uint32_t failure = 0;
+            uint32_t length = 0; // Length of the longest pattern ending in this state
+            Decision decision = Decision::None;
+            std::vector<std::pair<unsigned char, uint32_t>> children;
+        };
+
+        // Follow failure links until a transition on the byte exists
+        uint32_t next(uint32_t state, const unsigned char byte) const;
+
+        static uint64_t getTransitionKey(const uint32_t state, const unsigned char byte) {
+            return (uint64_t(state) << 8) | byte;
+        }
+
+        std::vector<State> m_states = std::vector<State>(1);
+        llvm::DenseMap<uint64_t, uint32_t> m_transitions;
+    };
+
+    Automaton m_pathRules;
+    Automaton m_symbolRules;
+    std::string m_policyFile;
+    std::string m_rules;
+    bool m_recordAnswers = false;
+
+    mutable std::mutex m_answerMutex;
+    std::vector<std::string> m_answers;
+};
+
+#endif // MOCK_POLICY_HPP_
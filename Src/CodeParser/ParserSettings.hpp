@@ -0,0 +1,73 @@
+/**
+  * @file: ParserSettings.hpp
+  * @brief: Settings which control how a translation unit is parsed and how its mock files are generated.
+  *         The settings are filled by the command line driver and handed over to every frontend action
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef PARSER_SETTINGS_HPP_
+#define PARSER_SETTINGS_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct MockModel;
+class MockPolicy;
+
+struct ParserSettings {
+    // Ask user on startup whether files to be mocked shall be confirmed one by one
+    // Batch runs can not read from std::cin, so they always run non-interactive
+    bool askInteractiveMode = true;
+
+    // When set, Rules of the policy decide which declarations are mocked instead of the user, No startup question.
+    // Files without a rule are asked only when the policy records answers(and askInteractiveMode is set)
+    MockPolicy* mockPolicy = nullptr;
+
+    // Print the "Happy Mocking" banner once mock files are generated
+    bool printGenerationBanner = true;
+
+    // Function bodies of headers are neither traversed nor needed for mocking, So they are skipped while parsing.
+    // Declarations, records and enums of headers stay complete
+    bool skipFunctionBodiesOutsideMainFile = true;
+
+    // Diagnostics are counted by category and only the first few messages of each file are printed(without source
+    // snippets) in a summary at the end. Used by the drivers, See CompactDiagnosticConsumer
+    bool compactDiagnostics = true;
+
+    // When set, collected mock information is moved here instead of being written to ./GeneratedMocks
+    // Used to merge the models of several translation units before generating mock files
+    MockModel* modelSink = nullptr;
+
+    // When set, absolute paths of all files the translation unit consists of are stored here
+    // Used to find out whether a cached result of the translation unit is still valid
+    std::vector<std::string>* includedFilesSink = nullptr;
+
+    // When set, bytes held by the AST and the source buffers of the translation unit are stored here
+    // Used to estimate the memory a translation unit needs when it is scheduled next time
+    std::size_t* memoryUsageSink = nullptr;
+
+    // Parsing stops at the next top-level declaration once the deadline passed or the AST and source buffers
+    // use more than memoryLimit bytes(0 means unlimited). Mock information of the declarations parsed so far is kept
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    std::size_t memoryLimit = 0;
+
+    // When set, receives true when parsing was stopped by a limit
+    bool* incompleteSink = nullptr;
+};
+
+#endif // PARSER_SETTINGS_HPP_
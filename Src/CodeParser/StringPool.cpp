@@ -0,0 +1,152 @@
+/**
+  * @file: StringPool.cpp
+  * @brief: The StringPool keeps one copy of every type name, identifier and file name of the mock model.
+  *         An InternedString is a 32-bit handle into the pool, So copying and comparing it for equality is as cheap
+  *         as copying and comparing an integer
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "StringPool.hpp"
+
+namespace {
+
+// Strings are stored in fixed size chunks which never move, So get() reads without locking
+// while other threads intern new strings. Up to 2^28 distinct strings
+const uint32_t chunkBits = 12;
+const uint32_t chunkSize = 1u << chunkBits;
+const uint32_t chunkCount = 1u << 16;
+
+// Workers intern at the same time all through the parse. Each string belongs to one shard by its hash,
+// So workers only wait for each other when their strings fall into the same shard
+const uint32_t shardBits = 6;
+const uint32_t shardCount = 1u << shardBits;
+
+// Own cache line, Threads locking neighbouring shards do not slow each other down
+struct alignas(64) Shard {
+    std::mutex mutex;
+    // Keys refer to the strings of the chunks
+    llvm::DenseMap<llvm::StringRef, uint32_t> handles;
+};
+
+struct Pool {
+    Pool() {
+        chunks[0].store(new std::string[chunkSize], std::memory_order_release);
+    }
+
+    std::atomic<std::string*> chunks[chunkCount] = {};
+    Shard shards[shardCount];
+    std::atomic<uint32_t> size = {1}; // Handle 0 - Empty string
+    std::atomic<uint32_t> generation = {0};
+};
+
+// Never destroyed, Model members may be read while static objects are destroyed
+Pool& getPool() {
+    static Pool* pool = new Pool();
+    return *pool;
+}
+
+// Chunks are created by the first thread storing a string into them
+std::string* getChunk(Pool& pool, const uint32_t chunkIndex) {
+    std::string* chunk = pool.chunks[chunkIndex].load(std::memory_order_acquire);
+    if(chunk) {
+        return chunk;
+    }
+
+    std::string* newChunk = new std::string[chunkSize];
+    if(pool.chunks[chunkIndex].compare_exchange_strong(chunk, newChunk, std::memory_order_acq_rel)) {
+        return newChunk;
+    }
+    delete[] newChunk; // Another thread was faster
+    return chunk;
+}
+
+}
+
+uint32_t StringPool::intern(llvm::StringRef value) {
+    if(value.empty()) {
+        return 0;
+    }
+
+    // DenseMap picks buckets by the low bits of the same hash, So the shard is taken from the high bits
+    Pool& pool = getPool();
+    const unsigned hash = llvm::DenseMapInfo<llvm::StringRef>::getHashValue(value);
+    Shard& shard = pool.shards[(hash >> (32 - shardBits)) & (shardCount - 1)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto itr = shard.handles.find(value);
+    if(shard.handles.end() != itr) {
+        return itr->second;
+    }
+
+    const uint32_t handle = pool.size.fetch_add(1, std::memory_order_relaxed);
+    if((handle >> chunkBits) >= chunkCount) {
+        std::cerr << "String pool is full" << std::endl;
+        std::abort();
+    }
+
+    std::string& stored = getChunk(pool, handle >> chunkBits)[handle & (chunkSize - 1)];
+    stored = value.str();
+    shard.handles[stored] = handle;
+    return handle;
+}
+
+const std::string& StringPool::get(const uint32_t handle) {
+    const std::string* chunk = getPool().chunks[handle >> chunkBits].load(std::memory_order_acquire);
+    return chunk[handle & (chunkSize - 1)];
+}
+
+void StringPool::reset() {
+    Pool& pool = getPool();
+    for(auto& each : pool.shards) {
+        each.handles.shrink_and_clear();
+    }
+    for(uint32_t i = 1; i < chunkCount; i++) {
+        delete[] pool.chunks[i].exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    // Handle 0 stays valid
+    std::string* firstChunk = pool.chunks[0].load(std::memory_order_acquire);
+    for(uint32_t i = 1; i < chunkSize; i++) {
+        std::string().swap(firstChunk[i]);
+    }
+    pool.size.store(1, std::memory_order_relaxed);
+    pool.generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t StringPool::getGeneration() {
+    return getPool().generation.load(std::memory_order_relaxed);
+}
+
+InternedConstant::operator InternedString() const {
+    // Threads racing on a new generation intern the same string, So they store the same value
+    const uint64_t generation = uint64_t(StringPool::getGeneration()) + 1;
+    uint64_t cached = m_handle.load(std::memory_order_relaxed);
+    if((cached >> 32) != generation) {
+        cached = (generation << 32) | StringPool::intern(m_value);
+        m_handle.store(cached, std::memory_order_relaxed);
+    }
+
+    InternedString result;
+    result.m_handle = static_cast<uint32_t>(cached);
+    return result;
+}
@@ -0,0 +1,165 @@
+/**
+  * @file: StringPool.hpp
+  * @brief: The StringPool keeps one copy of every type name, identifier and file name of the mock model.
+  *         An InternedString is a 32-bit handle into the pool, So copying and comparing it for equality is as cheap
+  *         as copying and comparing an integer
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// One pool per process, Shared by all threads. Strings are only removed by reset(), So handles stay valid until then.
+// Every reset() starts a new generation of the pool. Debug builds assert that no InternedString of an older
+// generation is used, Its handle may refer to another string or to freed memory
+// Handles are only meaningful inside the process which created them, Serialized models contain the strings
+// (See MockModelSerializer)
+//
+// Handle 0 is the empty string, So a default constructed InternedString is empty like a default constructed std::string
+
+#ifndef STRING_POOL_HPP_
+#define STRING_POOL_HPP_
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <string>
+
+#include "llvm/ADT/StringRef.h"
+
+class StringPool {
+public:
+
+    /** Intern
+     * @arg value: String to be stored
+     * @return uint32_t: Handle of the string, Equal strings always give the same handle
+     */
+    static uint32_t intern(llvm::StringRef value);
+
+    // String of a handle returned by intern(), The reference stays valid until reset()
+    static const std::string& get(const uint32_t handle);
+
+    /** Reset
+     * @brief: Drop all strings and free their memory. Processes which keep running after a model is done(daemon)
+     *         call it between models, So the pool neither grows without bound nor runs out of handles
+     *         Not thread-safe, No other thread may use the pool and no InternedString may be used afterwards
+     */
+    static void reset();
+
+    // Number of reset() calls so far
+    static uint32_t getGeneration();
+};
+
+class InternedString {
+public:
+    InternedString() = default;
+
+    // Implicit, So model members can be assigned from the strings clang returns
+    InternedString(llvm::StringRef value)
+        : m_handle(StringPool::intern(value)) {
+    }
+
+    InternedString(const std::string& value)
+        : m_handle(StringPool::intern(value)) {
+    }
+
+    InternedString(const char* value)
+        : m_handle(StringPool::intern(value)) {
+    }
+
+    const std::string& str() const {
+        return StringPool::get(getHandle());
+    }
+
+    // Generators append model members to std::string
+    operator const std::string&() const {
+        return str();
+    }
+
+    uint32_t getHandle() const {
+        // Handle 0 is the only one valid in every generation
+        assert((0 == m_handle) || (m_generation == StringPool::getGeneration()));
+        return m_handle;
+    }
+
+    bool empty() const {
+        return 0 == m_handle;
+    }
+
+    std::size_t size() const {
+        return str().size();
+    }
+
+    bool operator ==(const InternedString& other) const {
+        return getHandle() == other.getHandle();
+    }
+
+    bool operator !=(const InternedString& other) const {
+        return getHandle() != other.getHandle();
+    }
+
+    // By content, So sorted output does not depend on the order strings were interned in
+    bool operator <(const InternedString& other) const {
+        return (getHandle() != other.getHandle()) && (str() < other.str());
+    }
+
+private:
+    friend class InternedConstant;
+
+    uint32_t m_handle = 0;
+#ifndef NDEBUG
+    uint32_t m_generation = StringPool::getGeneration();
+#endif
+};
+
+// Constant of the model(e.g. a default value), Interned once per generation of the pool instead of on every use.
+// Getting the string of the current generation takes no lock
+class InternedConstant {
+public:
+    constexpr explicit InternedConstant(const char* value)
+        : m_value(value) {
+    }
+    ~InternedConstant() = default;
+    InternedConstant& operator =(const InternedConstant&) = delete;
+    InternedConstant(const InternedConstant&) = delete;
+
+    operator InternedString() const;
+
+private:
+    const char* m_value;
+    mutable std::atomic<uint64_t> m_handle = {0}; // Generation + 1 in the upper half, 0 when not interned yet
+};
+
+// Comparing with plain strings does not add them to the pool. Contents are compared in place, Without a copy,
+// But at the cost of a string comparison instead of a handle comparison
+inline bool operator ==(const InternedString& lhs, const std::string& rhs) {
+    return lhs.str() == rhs;
+}
+
+inline bool operator ==(const std::string& lhs, const InternedString& rhs) {
+    return lhs == rhs.str();
+}
+
+inline bool operator ==(const InternedString& lhs, const char* rhs) {
+    return lhs.str() == rhs;
+}
+
+inline bool operator !=(const InternedString& lhs, const std::string& rhs) {
+    return lhs.str() != rhs;
+}
+
+inline bool operator !=(const InternedString& lhs, const char* rhs) {
+    return lhs.str() != rhs;
+}
+
+#endif // STRING_POOL_HPP_
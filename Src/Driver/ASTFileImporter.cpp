@@ -0,0 +1,57 @@
+/**
+  * @file: ASTFileImporter.cpp
+  * @brief: The ASTFileImporter loads serialized ASTs(clang -emit-ast output) produced by the build and collects mock
+  *         information from them, So source files already compiled to an AST are not parsed a second time
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <iostream>
+
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileSystemOptions.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "llvm/Support/Path.h"
+
+#include "ASTFileImporter.hpp"
+#include "CustomASTConsumer.hpp"
+
+ASTFileImporter::ASTFileImporter()
+    : m_pchContainerOps(std::make_shared<clang::PCHContainerOperations>()) {
+}
+
+bool ASTFileImporter::import(const std::string& astFile, const ParserSettings& settings) {
+    llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> diagnostics =
+        clang::CompilerInstance::createDiagnostics(new clang::DiagnosticOptions());
+
+    // Headers are not read again, Everything is deserialized from the AST file on demand
+    std::unique_ptr<clang::ASTUnit> astUnit = clang::ASTUnit::LoadFromASTFile(
+        astFile, m_pchContainerOps->getRawReader(), clang::ASTUnit::LoadEverything, diagnostics,
+        clang::FileSystemOptions());
+    if(! astUnit) {
+        std::cerr << "Unable to load AST file " << astFile << std::endl;
+        return false;
+    }
+
+    // Main file of the AST is the source file it was built from, So HandleTranslationUnit filters as usual
+    CustomASTConsumer consumer(astUnit->getSourceManager(), settings);
+    consumer.HandleTranslationUnit(astUnit->getASTContext());
+    return ! diagnostics->hasErrorOccurred();
+}
+
+bool ASTFileImporter::isASTFile(llvm::StringRef fileName) {
+    return ".ast" == llvm::sys::path::extension(fileName);
+}
@@ -0,0 +1,55 @@
+/**
+  * @file: ASTFileImporter.hpp
+  * @brief: The ASTFileImporter loads serialized ASTs(clang -emit-ast output) produced by the build and collects mock
+  *         information from them, So source files already compiled to an AST are not parsed a second time
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef AST_FILE_IMPORTER_HPP_
+#define AST_FILE_IMPORTER_HPP_
+
+#include <memory>
+#include <string>
+
+#include "clang/Frontend/PCHContainerOperations.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "ParserSettings.hpp"
+
+class ASTFileImporter {
+public:
+    explicit ASTFileImporter();
+    ~ASTFileImporter() = default;
+    ASTFileImporter& operator =(const ASTFileImporter&) = delete;
+    ASTFileImporter(const ASTFileImporter&) = delete;
+
+    /** Import
+     * @brief: Load the AST file and run CustomASTConsumer over it like over a parsed translation unit, Thread-safe.
+     *         Only declarations of the main file the AST was built from are visited
+     * @arg astFile: Serialized AST
+     * @arg settings: Same settings as for parsing
+     * @return bool: false when the file can not be loaded(e.g. written by another clang version)
+     */
+    bool import(const std::string& astFile, const ParserSettings& settings);
+
+    // true when the file is a serialized AST rather than a source file
+    static bool isASTFile(llvm::StringRef fileName);
+
+private:
+    std::shared_ptr<clang::PCHContainerOperations> m_pchContainerOps;
+};
+
+#endif // AST_FILE_IMPORTER_HPP_
@@ -0,0 +1,443 @@
+/**
+  * @file: BatchRunner.cpp
+  * @brief: The BatchRunner runs CustomFrontendAction over a list of translation units of a compilation database.
+  *         Translation units are parsed in parallel on a pool of worker threads, Each worker owns its ClangTool.
+  *         Mock information of all translation units is merged and written once to ./GeneratedMocks
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <tuple>
+
+#include "clang/Frontend/PCHContainerOperations.h"
+#include "clang/Tooling/ArgumentsAdjusters.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/GlobPattern.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+#include "BatchRunner.hpp"
+#include "BatchScheduler.hpp"
+#include "CompactDiagnosticConsumer.hpp"
+#include "ForkServer.hpp"
+#include "CustomFrontendAction.hpp"
+#include "MergeStage.hpp"
+#include "MockFileEmitter.hpp"
+#include "MockModelSerializer.hpp"
+#include "Sharding.hpp"
+
+namespace {
+
+// Result of a forked worker, "<success> <cached> <incomplete> <wall time> <memory usage>\n" followed by the serialized model
+std::string serializeResult(const TranslationUnitReport& report, const MockModel& model) {
+    MockModelSerializer serializer;
+    return std::to_string(report.success) + " " + std::to_string(report.cached) + " " +
+           std::to_string(report.incomplete) + " " + std::to_string(report.wallTime.count()) + " " +
+           std::to_string(report.memoryUsage) + "\n" + serializer.serialize(model);
+}
+
+bool deserializeResult(llvm::StringRef data, TranslationUnitReport& report, MockModel& model) {
+    llvm::StringRef header;
+    std::tie(header, data) = data.split('\n');
+    llvm::SmallVector<llvm::StringRef, 5> fields;
+    header.split(fields, ' ');
+
+    unsigned success = 0;
+    unsigned cached = 0;
+    unsigned incomplete = 0;
+    uint64_t wallTime = 0;
+    MockModelSerializer serializer;
+    if((5 != fields.size()) || fields[0].getAsInteger(10, success) || fields[1].getAsInteger(10, cached) ||
+       fields[2].getAsInteger(10, incomplete) || fields[3].getAsInteger(10, wallTime) ||
+       fields[4].getAsInteger(10, report.memoryUsage) || ! serializer.deserialize(data, model)) {
+        return false;
+    }
+    report.success = (1 == success);
+    report.cached = (1 == cached);
+    report.incomplete = (1 == incomplete);
+    report.wallTime = std::chrono::milliseconds(wallTime);
+    return true;
+}
+
+}
+
+BatchRunner::BatchRunner(const clang::tooling::CompilationDatabase& compilations, const ParserSettings& settings,
+                         const unsigned jobs)
+    : m_compilations(compilations)
+    , m_settings(settings)
+    , m_jobs(jobs) {
+
+    // Nobody can answer questions from worker threads
+    m_settings.askInteractiveMode = false;
+    m_settings.printGenerationBanner = false;
+}
+
+int BatchRunner::run(const std::vector<std::string>& sourceFiles) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // Files might have changed since the previous run. Cached contents are at least as new as the revalidation,
+    // So results of files modified later are not stored
+    m_fileReadTime = std::chrono::system_clock::now();
+    m_fileCache.revalidate(*createWorkerFileSystem());
+
+    // Each worker writes only its own report, So no locking is required
+    m_reports.assign(sourceFiles.size(), {});
+    const unsigned jobs = m_jobs ? m_jobs : llvm::hardware_concurrency();
+
+    // Shards keep the model of each translation unit, Otherwise models are merged while parsing goes on.
+    // Forking requires a single thread, So the driver merges between its children then
+    std::vector<MockModel> models(m_shardFile.empty() ? 0 : sourceFiles.size());
+    const std::vector<std::size_t> mergePositions = getMergePositions(sourceFiles);
+    std::unique_ptr<MergeStage> mergeStage;
+    if(m_shardFile.empty()) {
+        mergeStage = std::make_unique<MergeStage>(m_forkWorkers ? 0 : (2 * jobs));
+    }
+    const auto collectModel = [&models, &mergePositions, &mergeStage](const std::size_t i, MockModel&& model) {
+        if(mergeStage) {
+            mergeStage->push(mergePositions[i], std::move(model));
+        } else {
+            models[i] = std::move(model);
+        }
+    };
+
+    BatchScheduler scheduler(getExpectedCosts(sourceFiles), m_memoryBudget);
+    if(m_forkWorkers) {
+        // Cooperative stop of the parser misses stalls inside one declaration and memory outside the AST,
+        // Children are limited by the kernel and killed then
+        ForkServer forkServer(jobs);
+        forkServer.setTimeLimit(m_timeLimit);
+        forkServer.setMemoryLimit(m_memoryLimit);
+        forkServer.run(scheduler, [this, &sourceFiles](const std::size_t i) {
+            MockModel model;
+            runTranslationUnit(sourceFiles[i], m_reports[i], model);
+            return serializeResult(m_reports[i], model);
+        }, [this, &sourceFiles, &collectModel](const std::size_t i, const bool exited, std::string&& result) {
+            MockModel model;
+            if(! exited || ! deserializeResult(result, m_reports[i], model)) {
+                std::cerr << "Worker process of " << sourceFiles[i] << " died" << std::endl;
+                m_reports[i].success = false;
+                model = {};
+            }
+            m_reports[i].fileName = sourceFiles[i];
+            collectModel(i, std::move(model));
+        });
+    } else {
+        // Every worker takes the next translation unit from the scheduler as soon as it is done with one
+        llvm::ThreadPool pool(jobs);
+        for(unsigned worker = 0; worker < jobs; worker++) {
+            pool.async([this, &sourceFiles, &scheduler, &collectModel]() {
+                for(std::size_t i = scheduler.acquire(); BatchScheduler::noTranslationUnit != i; i = scheduler.acquire()) {
+                    MockModel model;
+                    runTranslationUnit(sourceFiles[i], m_reports[i], model);
+                    scheduler.release(i);
+                    collectModel(i, std::move(model));
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    // Cached translation units tell nothing about the cost of parsing them. Neither do translation units stopped by a
+    // limit, Nor workers which died before reporting(no wall time)
+    if(m_costHistory) {
+        for(const auto& each : m_reports) {
+            if(! each.cached && ! each.incomplete && each.wallTime.count()) {
+                m_costHistory->setCost(each.fileName, {static_cast<uint64_t>(each.wallTime.count()), each.memoryUsage});
+            }
+        }
+        if(! m_costHistory->save()) {
+            std::cerr << "Unable to write the cost history" << std::endl;
+        }
+    }
+
+    if(m_resultCache) {
+        m_resultCache->evict();
+    }
+
+    const auto mergeStartTime = std::chrono::steady_clock::now();
+    bool shardWritten = true;
+    if(! m_shardFile.empty()) {
+        // Merged later along with the other shards
+        std::vector<ShardEntry> entries(sourceFiles.size());
+        for(std::size_t i = 0; i < sourceFiles.size(); i++) {
+            entries[i] = {m_reports[i].fileName, m_reports[i].success, std::move(models[i])};
+        }
+        shardWritten = Sharding::writeShard(m_shardFile, entries);
+        if(! shardWritten) {
+            std::cerr << "Unable to write shard file " << m_shardFile << std::endl;
+        }
+    } else {
+        // Every model is folded already, finish() only waits for the queue and puts the entries in position order
+        const MockModel mergedModel = mergeStage->finish();
+        MockFileEmitter mockFileEmitter;
+        mockFileEmitter.emit(mergedModel);
+    }
+
+    const auto endTime = std::chrono::steady_clock::now();
+    m_mergeWallTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - mergeStartTime);
+    m_totalWallTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+
+    if(! shardWritten) {
+        return 1;
+    }
+    for(const auto& each : m_reports) {
+        if(! each.success) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void BatchRunner::runTranslationUnit(const std::string& fileName, TranslationUnitReport& report, MockModel& model) {
+    const auto startTime = std::chrono::steady_clock::now();
+    report.fileName = fileName;
+
+    // Serialized ASTs need neither a compile command nor a parse
+    if(ASTFileImporter::isASTFile(fileName)) {
+        ParserSettings settings = m_settings;
+        settings.modelSink = &model;
+        settings.memoryUsageSink = &report.memoryUsage;
+        report.success = m_astFileImporter.import(fileName, settings);
+        report.wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        return;
+    }
+
+    const std::vector<clang::tooling::CompileCommand> compileCommands = m_compilations.getCompileCommands(fileName);
+    ResultCache* resultCache = compileCommands.empty() ? nullptr : m_resultCache;
+
+    // Falls back to the manifest of the last parse when the scan fails
+    std::vector<std::string> reachableFiles;
+    const bool scanned = resultCache && m_dependencyScanner &&
+                         m_dependencyScanner->scan(compileCommands.front(), reachableFiles);
+    const std::vector<std::string>* scannedFiles = scanned ? &reachableFiles : nullptr;
+    if(resultCache && resultCache->lookup(compileCommands.front(), model, report.success, scannedFiles)) {
+        report.cached = true;
+        report.wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        return;
+    }
+
+    // Each worker gets its own file system, ClangTool changes the working directory
+    // of the file system for every compile command and workers must not affect each other
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem = m_fileCache.createFileSystem(createWorkerFileSystem());
+    clang::tooling::ClangTool tool(m_compilations, {fileName},
+                                   std::make_shared<clang::PCHContainerOperations>(), fileSystem);
+    const auto extraArgumentsItr = m_extraArguments.find(fileName);
+    std::vector<std::string> extraArguments =
+        (m_extraArguments.end() != extraArgumentsItr) ? extraArgumentsItr->second : std::vector<std::string>();
+    if(m_preambleCache && ! compileCommands.empty()) {
+        const std::vector<std::string> preambleArguments = m_preambleCache->prepare(compileCommands.front());
+        extraArguments.insert(extraArguments.end(), preambleArguments.begin(), preambleArguments.end());
+    }
+    if(! extraArguments.empty()) {
+        tool.appendArgumentsAdjuster(clang::tooling::getInsertArgumentAdjuster(extraArguments,
+                                     clang::tooling::ArgumentInsertPosition::END));
+    }
+    CompactDiagnosticConsumer diagnosticConsumer;
+    if(m_settings.compactDiagnostics) {
+        tool.setDiagnosticConsumer(&diagnosticConsumer);
+    }
+
+    ParserSettings settings = m_settings;
+    settings.modelSink = &model;
+    settings.memoryUsageSink = &report.memoryUsage;
+    settings.incompleteSink = &report.incomplete;
+    settings.memoryLimit = m_memoryLimit;
+    if(m_timeLimit.count()) {
+        settings.deadline = startTime + m_timeLimit;
+    }
+    std::vector<std::string> includedFiles;
+    if(resultCache) {
+        settings.includedFilesSink = &includedFiles;
+    }
+    CustomFrontendActionFactory actionFactory(settings);
+    report.success = (0 == tool.run(&actionFactory)) && ! report.incomplete;
+
+    // Nothing to store when the frontend did not even reach the AST or was stopped by a limit
+    if(resultCache && ! includedFiles.empty() && ! report.incomplete) {
+        resultCache->store(compileCommands.front(), extraArguments, model, report.success, includedFiles,
+                           m_fileReadTime, scannedFiles);
+    }
+
+    report.wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+}
+
+std::vector<std::size_t> BatchRunner::getMergePositions(const std::vector<std::string>& sourceFiles) {
+    std::vector<std::size_t> order(sourceFiles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sourceFiles](const std::size_t lhs, const std::size_t rhs) {
+        return sourceFiles[lhs] < sourceFiles[rhs];
+    });
+
+    std::vector<std::size_t> positions(sourceFiles.size());
+    for(std::size_t position = 0; position < order.size(); position++) {
+        positions[order[position]] = position;
+    }
+    return positions;
+}
+
+std::vector<TranslationUnitCost> BatchRunner::getExpectedCosts(const std::vector<std::string>& sourceFiles) const {
+    std::vector<TranslationUnitCost> costs(sourceFiles.size());
+    std::vector<bool> known(sourceFiles.size(), false);
+    TranslationUnitCost total;
+    std::size_t knownCount = 0;
+    for(std::size_t i = 0; m_costHistory && (i < sourceFiles.size()); i++) {
+        known[i] = m_costHistory->getCost(sourceFiles[i], costs[i]);
+        if(known[i]) {
+            total.wallTime += costs[i].wallTime;
+            total.memory += costs[i].memory;
+            ++knownCount;
+        }
+    }
+
+    for(std::size_t i = 0; (knownCount > 0) && (i < sourceFiles.size()); i++) {
+        if(! known[i]) {
+            costs[i] = {total.wallTime / knownCount, total.memory / knownCount};
+        }
+    }
+    return costs;
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> BatchRunner::createWorkerFileSystem() const {
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem = llvm::vfs::createPhysicalFileSystem().release();
+    if(m_headerIndex) {
+        fileSystem = m_headerIndex->createFileSystem(fileSystem);
+    }
+    if(m_sysrootImage) {
+        fileSystem = m_sysrootImage->createFileSystem(fileSystem);
+    }
+    return fileSystem;
+}
+
+void BatchRunner::setExtraArguments(const ExtraArgumentsType& extraArguments) {
+    m_extraArguments = extraArguments;
+}
+
+void BatchRunner::setPreambleCache(PreambleCache* preambleCache) {
+    m_preambleCache = preambleCache;
+}
+
+void BatchRunner::setResultCache(ResultCache* resultCache) {
+    m_resultCache = resultCache;
+}
+
+void BatchRunner::setDependencyScanner(DependencyScanner* dependencyScanner) {
+    m_dependencyScanner = dependencyScanner;
+}
+
+void BatchRunner::setSysrootImage(const SysrootImage* sysrootImage) {
+    m_sysrootImage = sysrootImage;
+}
+
+void BatchRunner::setHeaderIndex(HeaderIndex* headerIndex) {
+    m_headerIndex = headerIndex;
+}
+
+void BatchRunner::setCostHistory(CostHistory* costHistory) {
+    m_costHistory = costHistory;
+}
+
+void BatchRunner::setMemoryBudget(const uint64_t memoryBudget) {
+    m_memoryBudget = memoryBudget;
+}
+
+void BatchRunner::setForkWorkers(const bool forkWorkers) {
+    m_forkWorkers = forkWorkers;
+}
+
+void BatchRunner::setLimits(const std::chrono::milliseconds timeLimit, const std::size_t memoryLimit) {
+    m_timeLimit = timeLimit;
+    m_memoryLimit = memoryLimit;
+}
+
+void BatchRunner::setShardFile(const std::string& shardFile) {
+    m_shardFile = shardFile;
+}
+
+void BatchRunner::printSummary() const {
+    std::size_t failures = 0;
+    std::size_t cacheHits = 0;
+    std::size_t incompletes = 0;
+
+    std::cout << "\33[1;35m\nBatch summary:\033[0m\n";
+    for(const auto& each : m_reports) {
+        if(each.success) {
+            std::cout << "\33[32m[ OK ]\033[0m ";
+        } else if(each.incomplete) {
+            std::cout << "\33[33m[PART]\033[0m ";
+            ++failures;
+            ++incompletes;
+        } else {
+            std::cout << "\33[31m[FAIL]\033[0m ";
+            ++failures;
+        }
+        std::cout << each.fileName << " (" << each.wallTime.count() << " ms";
+        if(each.memoryUsage) {
+            std::cout << ", " << (each.memoryUsage / (1024 * 1024)) << " MiB";
+        }
+        std::cout << (each.cached ? ", cached" : "") << ")\n";
+        cacheHits += each.cached;
+    }
+
+    std::cout << "\33[1;35m\nTranslation units: " << m_reports.size()
+              << ", Succeeded: " << (m_reports.size() - failures)
+              << ", Failed: " << failures
+              << ", Incomplete: " << incompletes
+              << ", Cached: " << cacheHits
+              << ", Merge and generation: " << m_mergeWallTime.count() << " ms"
+              << ", Wall time: " << m_totalWallTime.count() << " ms\033[0m" << std::endl;
+
+    const SharedFileCache::Statistics fileCacheStatistics = m_fileCache.getStatistics();
+    std::cout << "\33[1;35mFile cache: " << fileCacheStatistics.statusHits << " of "
+              << (fileCacheStatistics.statusHits + fileCacheStatistics.statusMisses) << " lookups and "
+              << fileCacheStatistics.contentHits << " of "
+              << (fileCacheStatistics.contentHits + fileCacheStatistics.contentMisses) << " reads shared, "
+              << fileCacheStatistics.invalidations << " invalidated\033[0m" << std::endl;
+
+    // Lookups of forked workers are made in the children, So they are not counted here
+    if(m_headerIndex) {
+        const HeaderIndex::Statistics headerIndexStatistics = m_headerIndex->getStatistics();
+        std::cout << "\33[1;35mHeader index: " << headerIndexStatistics.rejected << " of "
+                  << headerIndexStatistics.lookups << " lookups answered as missing, "
+                  << headerIndexStatistics.directoriesRead << " directories read\033[0m" << std::endl;
+    }
+}
+
+std::vector<std::string> BatchRunner::selectSourceFiles(const clang::tooling::CompilationDatabase& compilations,
+                                                        const std::string& globPattern) {
+    std::vector<std::string> allFiles = compilations.getAllFiles();
+    if(globPattern.empty()) {
+        return allFiles;
+    }
+
+    llvm::Expected<llvm::GlobPattern> pattern = llvm::GlobPattern::create(globPattern);
+    if(! pattern) {
+        std::cerr << "Invalid batch filter '" << globPattern << "': " << llvm::toString(pattern.takeError()) << std::endl;
+        return {};
+    }
+
+    std::vector<std::string> selectedFiles;
+    for(const auto& each : allFiles) {
+        if(pattern->match(each)) {
+            selectedFiles.push_back(each);
+        }
+    }
+    return selectedFiles;
+}
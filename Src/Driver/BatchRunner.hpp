@@ -0,0 +1,163 @@
+/**
+  * @file: BatchRunner.hpp
+  * @brief: The BatchRunner runs CustomFrontendAction over a list of translation units of a compilation database.
+  *         Translation units are parsed in parallel on a pool of worker threads, Each worker owns its ClangTool.
+  *         Mock information of all translation units is merged and written once to ./GeneratedMocks
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef BATCH_RUNNER_HPP_
+#define BATCH_RUNNER_HPP_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+#include "ASTFileImporter.hpp"
+#include "CostHistory.hpp"
+#include "DependencyScanner.hpp"
+#include "HeaderIndex.hpp"
+#include "MockGeneratorTypes.hpp"
+#include "ParserSettings.hpp"
+#include "PreambleCache.hpp"
+#include "ResultCache.hpp"
+#include "SharedFileCache.hpp"
+#include "SysrootImage.hpp"
+#include "SystemHeaderPCH.hpp"
+
+// Outcome of a single translation unit
+struct TranslationUnitReport {
+    std::string fileName;
+    bool success = false;
+    bool cached = false;
+    std::chrono::milliseconds wallTime = {};
+    std::size_t memoryUsage = 0; // Bytes of AST and source buffers, 0 when not parsed
+    bool incomplete = false; // Parsing was stopped by a limit, Mock information is partial
+};
+
+class BatchRunner {
+public:
+
+    // jobs - Number of worker threads, 0 means one worker per hardware thread
+    explicit BatchRunner(const clang::tooling::CompilationDatabase& compilations, const ParserSettings& settings,
+                         const unsigned jobs = 0);
+    ~BatchRunner() = default;
+    BatchRunner& operator =(const BatchRunner&) = delete;
+    BatchRunner(const BatchRunner&) = delete;
+
+    /** Run batch
+     * @brief: Parse every given source file, merge mock information of all of them and generate mock files
+     * @arg sourceFiles: Translation units to be processed, Serialized ASTs(*.ast) are loaded instead of parsed
+     * @return int: 0 when all translation units succeeded, 1 otherwise
+     */
+    int run(const std::vector<std::string>& sourceFiles);
+
+    // Arguments added to the compile command of the given source files(e.g. to include a PCH)
+    void setExtraArguments(const ExtraArgumentsType& extraArguments);
+
+    // Make every parsed translation unit use the precompiled preamble of its source file. Preambles are prepared by
+    // the worker right before the parse, So they are built in parallel. Cache must outlive the runner
+    void setPreambleCache(PreambleCache* preambleCache);
+
+    // Take results of unchanged translation units from the cache and store new ones, Cache must outlive the runner
+    void setResultCache(ResultCache* resultCache);
+
+    // Look up cached results by the files a dependency scan finds instead of the files of the last parse,
+    // Changed headers are detected without a parse. Only used along with a result cache, Scanner must outlive the runner
+    void setDependencyScanner(DependencyScanner* dependencyScanner);
+
+    // Serve headers below the packed sysroot trees from the image, Image must outlive the runner
+    void setSysrootImage(const SysrootImage* sysrootImage);
+
+    // Answer lookups of headers the index knows to be missing without the file system, Index must outlive the runner
+    void setHeaderIndex(HeaderIndex* headerIndex);
+
+    // Start translation units in order of their wall time recorded in the history, Record the costs of this run
+    // History must outlive the runner
+    void setCostHistory(CostHistory* costHistory);
+
+    // Run translation units concurrently only as long as their recorded memory fits into the budget(bytes), 0 means unlimited
+    void setMemoryBudget(const uint64_t memoryBudget);
+
+    // Run each translation unit in a process forked from the current one instead of a worker thread.
+    // Children inherit everything loaded so far, Crashes and global state of the frontend stay in the child
+    void setForkWorkers(const bool forkWorkers);
+
+    /** Set limits
+     * @brief: Parsing of a translation unit stops at the next top-level declaration once it exceeds a limit.
+     *         Mock information collected so far is kept and the translation unit is reported incomplete
+     * @arg timeLimit: Wall time of one translation unit, 0 means unlimited
+     * @arg memoryLimit: Bytes of AST and source buffers of one translation unit, 0 means unlimited. Checked every few
+     *                   top-level declarations, So it is approximate. Forked workers are limited by the kernel as well
+     *                   (See ForkServer::setMemoryLimit())
+     */
+    void setLimits(const std::chrono::milliseconds timeLimit, const std::size_t memoryLimit);
+
+    // Write the mock information of each translation unit to the shard file instead of generating mock files
+    // See Sharding::mergeShards()
+    void setShardFile(const std::string& shardFile);
+
+    // Print successes, failures and wall time of each translation unit processed by run()
+    void printSummary() const;
+
+    // Select source files of the compilation database matching the given glob pattern
+    // Empty pattern selects every file
+    static std::vector<std::string> selectSourceFiles(const clang::tooling::CompilationDatabase& compilations,
+                                                      const std::string& globPattern);
+
+private:
+    // Parse one translation unit, fill its report and collect its mock information into model
+    void runTranslationUnit(const std::string& fileName, TranslationUnitReport& report, MockModel& model);
+
+    // Position of each source file in the merge order, Source files are merged in order of their names.
+    // Same order as the merge of shard files, So both give the same mock files
+    static std::vector<std::size_t> getMergePositions(const std::vector<std::string>& sourceFiles);
+
+    // Costs of the source files recorded in the history, Unknown ones are expected to cost the average
+    std::vector<TranslationUnitCost> getExpectedCosts(const std::vector<std::string>& sourceFiles) const;
+
+    // File system of one worker, Without the shared file cache
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> createWorkerFileSystem() const;
+
+    const clang::tooling::CompilationDatabase& m_compilations;
+    ParserSettings m_settings;
+    unsigned m_jobs = 0;
+    ExtraArgumentsType m_extraArguments;
+    PreambleCache* m_preambleCache = nullptr;
+    ResultCache* m_resultCache = nullptr;
+    DependencyScanner* m_dependencyScanner = nullptr;
+    const SysrootImage* m_sysrootImage = nullptr;
+    HeaderIndex* m_headerIndex = nullptr;
+    std::string m_shardFile;
+    CostHistory* m_costHistory = nullptr;
+    uint64_t m_memoryBudget = 0;
+    bool m_forkWorkers = false;
+    std::chrono::milliseconds m_timeLimit = {};
+    std::size_t m_memoryLimit = 0;
+
+    // Status and contents of headers are shared by all translation units of the runner
+    SharedFileCache m_fileCache;
+    llvm::sys::TimePoint<> m_fileReadTime; // Revalidation of the file cache, Files modified later are too new for the result cache
+    ASTFileImporter m_astFileImporter;
+
+    std::vector<TranslationUnitReport> m_reports;
+    std::chrono::milliseconds m_totalWallTime = {};
+    std::chrono::milliseconds m_mergeWallTime = {};
+};
+
+#endif // BATCH_RUNNER_HPP_
@@ -0,0 +1,81 @@
+/**
+  * @file: BatchScheduler.cpp
+  * @brief: The BatchScheduler hands out translation units to the workers of a batch run. The most expensive translation
+  *         units go first, So no worker starts a big one when the others are about to finish. Translation units whose
+  *         memory would exceed the budget along with the running ones wait, Smaller ones are taken meanwhile
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <numeric>
+
+#include "BatchScheduler.hpp"
+
+constexpr std::size_t BatchScheduler::noTranslationUnit;
+
+BatchScheduler::BatchScheduler(const std::vector<TranslationUnitCost>& costs, const uint64_t memoryBudget)
+    : m_costs(costs)
+    , m_memoryBudget(memoryBudget)
+    , m_pending(costs.size()) {
+
+    // Longest first, Equal costs keep their order
+    std::iota(m_pending.begin(), m_pending.end(), 0);
+    std::stable_sort(m_pending.begin(), m_pending.end(), [this](const std::size_t lhs, const std::size_t rhs) {
+        return m_costs[lhs].wallTime > m_costs[rhs].wallTime;
+    });
+}
+
+std::size_t BatchScheduler::acquire() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(! m_pending.empty()) {
+        const std::size_t index = takeNext();
+        if(noTranslationUnit != index) {
+            return index;
+        }
+        m_released.wait(lock);
+    }
+    return noTranslationUnit;
+}
+
+std::size_t BatchScheduler::tryAcquire() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return takeNext();
+}
+
+void BatchScheduler::release(const std::size_t index) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_memoryInUse -= m_costs[index].memory;
+        --m_running;
+    }
+    m_released.notify_all();
+}
+
+std::size_t BatchScheduler::takeNext() {
+    // Most expensive translation unit which fits into the remaining budget
+    const auto next = std::find_if(m_pending.begin(), m_pending.end(), [this](const std::size_t each) {
+        return (0 == m_memoryBudget) || (0 == m_running) || (m_memoryInUse + m_costs[each].memory <= m_memoryBudget);
+    });
+    if(m_pending.end() == next) {
+        return noTranslationUnit;
+    }
+
+    const std::size_t index = *next;
+    m_pending.erase(next);
+    m_memoryInUse += m_costs[index].memory;
+    ++m_running;
+    return index;
+}
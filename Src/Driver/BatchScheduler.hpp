@@ -0,0 +1,74 @@
+/**
+  * @file: BatchScheduler.hpp
+  * @brief: The BatchScheduler hands out translation units to the workers of a batch run. The most expensive translation
+  *         units go first, So no worker starts a big one when the others are about to finish. Translation units whose
+  *         memory would exceed the budget along with the running ones wait, Smaller ones are taken meanwhile
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef BATCH_SCHEDULER_HPP_
+#define BATCH_SCHEDULER_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "CostHistory.hpp"
+
+class BatchScheduler {
+public:
+
+    // Returned by acquire() when every translation unit has been handed out
+    static constexpr std::size_t noTranslationUnit = std::numeric_limits<std::size_t>::max();
+
+    /** Constructor
+     * @arg costs: Expected cost of each translation unit, Indices are the ones returned by acquire()
+     * @arg memoryBudget: Bytes all running translation units may use together, 0 means unlimited.
+     *                    A translation unit exceeding the budget on its own runs when nothing else runs
+     */
+    explicit BatchScheduler(const std::vector<TranslationUnitCost>& costs, const uint64_t memoryBudget);
+    ~BatchScheduler() = default;
+    BatchScheduler& operator =(const BatchScheduler&) = delete;
+    BatchScheduler(const BatchScheduler&) = delete;
+
+    // Next translation unit to be run by the calling worker, Blocks while the memory budget is exhausted.
+    // Returns noTranslationUnit when nothing is left
+    std::size_t acquire();
+
+    // Same as acquire() without blocking, Returns noTranslationUnit as well when nothing can start right now.
+    // Never returns noTranslationUnit while nothing runs and translation units are left
+    std::size_t tryAcquire();
+
+    // Translation unit returned by acquire() finished, Its memory is available again
+    void release(const std::size_t index);
+
+private:
+    // Take the next translation unit which can start now, Caller holds the mutex
+    std::size_t takeNext();
+
+    std::vector<TranslationUnitCost> m_costs;
+    uint64_t m_memoryBudget = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    std::vector<std::size_t> m_pending; // Most expensive first
+    uint64_t m_memoryInUse = 0;
+    std::size_t m_running = 0;
+};
+
+#endif // BATCH_SCHEDULER_HPP_
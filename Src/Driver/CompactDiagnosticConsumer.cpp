@@ -0,0 +1,153 @@
+/**
+  * @file: CompactDiagnosticConsumer.cpp
+  * @brief: The CompactDiagnosticConsumer counts the diagnostics of a translation unit by category and keeps only the
+  *         first few messages of each file. Cross-target sysroots easily produce thousands of errors, Formatting and
+  *         printing each of them with its source snippet costs more than the parse itself
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <iostream>
+#include <sstream>
+
+#include "clang/Basic/DiagnosticIDs.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/SmallString.h"
+
+#include "CompactDiagnosticConsumer.hpp"
+
+namespace {
+
+const char* getLevelName(const clang::DiagnosticsEngine::Level level) {
+    switch(level) {
+    case clang::DiagnosticsEngine::Note:
+        return "note";
+    case clang::DiagnosticsEngine::Remark:
+        return "remark";
+    case clang::DiagnosticsEngine::Warning:
+        return "warning";
+    case clang::DiagnosticsEngine::Fatal:
+        return "fatal error";
+    default:
+        return "error";
+    }
+}
+
+}
+
+CompactDiagnosticConsumer::CompactDiagnosticConsumer(const unsigned messagesPerFile)
+    : m_messagesPerFile(messagesPerFile) {
+}
+
+void CompactDiagnosticConsumer::HandleDiagnostic(clang::DiagnosticsEngine::Level level, const clang::Diagnostic& info) {
+    // Error and warning counts of the engine
+    clang::DiagnosticConsumer::HandleDiagnostic(level, info);
+
+    if(clang::DiagnosticsEngine::Note == level) {
+        if(! m_lastKept) {
+            return;
+        }
+    } else {
+        if(clang::DiagnosticsEngine::Warning == level) {
+            ++m_warnings;
+        } else if(level >= clang::DiagnosticsEngine::Error) {
+            ++m_errors;
+        }
+        const llvm::StringRef category =
+            clang::DiagnosticIDs::getCategoryNameFromID(clang::DiagnosticIDs::getCategoryNumberForDiag(info.getID()));
+        ++m_categoryCounts[category.empty() ? "Other" : category.str()];
+    }
+
+    // Only kept messages are formatted, Source snippets are never rendered
+    FileDiagnostics& fileDiagnostics = getFileDiagnostics(info);
+    if((clang::DiagnosticsEngine::Note != level) && (fileDiagnostics.messages.size() >= m_messagesPerFile)) {
+        ++fileDiagnostics.dropped;
+        m_lastKept = false;
+        return;
+    }
+    m_lastKept = true;
+
+    std::string message;
+    if(info.getLocation().isValid() && info.hasSourceManager()) {
+        const clang::PresumedLoc location = info.getSourceManager().getPresumedLoc(info.getLocation());
+        if(location.isValid()) {
+            message = std::string(location.getFilename()) + ":" + std::to_string(location.getLine()) + ":" +
+                      std::to_string(location.getColumn()) + ": ";
+        }
+    }
+    llvm::SmallString<256> text;
+    info.FormatDiagnostic(text);
+    message.append(std::string(getLevelName(level)) + ": " + text.str().str());
+    fileDiagnostics.messages.push_back(std::move(message));
+}
+
+void CompactDiagnosticConsumer::finish() {
+    if(m_files.empty()) {
+        return; // Clean translation unit
+    }
+
+    std::ostringstream summary;
+    summary << (m_mainFile.empty() ? "<command line>" : m_mainFile) << ": " << m_errors << " errors, "
+            << m_warnings << " warnings(";
+    for(auto it = m_categoryCounts.begin(); it != m_categoryCounts.end(); ++it) {
+        summary << (m_categoryCounts.begin() != it ? ", " : "") << it->first << ": " << it->second;
+    }
+    summary << ")\n";
+    for(const auto& each : m_files) {
+        for(const auto& message : each.messages) {
+            summary << "    " << message << "\n";
+        }
+        if(each.dropped) {
+            summary << "    ... " << each.dropped << " more in " << each.fileName << "\n";
+        }
+    }
+    std::cerr << summary.str() << std::flush;
+
+    m_mainFile.clear();
+    m_files.clear();
+    m_fileIndices.clear();
+    m_categoryCounts.clear();
+    m_errors = 0;
+    m_warnings = 0;
+    m_lastKept = false;
+}
+
+CompactDiagnosticConsumer::FileDiagnostics& CompactDiagnosticConsumer::getFileDiagnostics(const clang::Diagnostic& info) {
+    // Diagnostics of the driver and the command line have no location
+    clang::FileID fileID;
+    if(info.getLocation().isValid() && info.hasSourceManager()) {
+        const clang::SourceManager& sourceManager = info.getSourceManager();
+        fileID = sourceManager.getFileID(sourceManager.getExpansionLoc(info.getLocation()));
+        if(m_mainFile.empty()) {
+            if(const clang::FileEntry* mainFileEntry = sourceManager.getFileEntryForID(sourceManager.getMainFileID())) {
+                m_mainFile = mainFileEntry->getName();
+            }
+        }
+    }
+
+    const auto itr = m_fileIndices.find(fileID);
+    if(m_fileIndices.end() != itr) {
+        return m_files[itr->second];
+    }
+
+    std::string fileName = "<command line>";
+    if(fileID.isValid()) {
+        const clang::FileEntry* fileEntry = info.getSourceManager().getFileEntryForID(fileID);
+        fileName = fileEntry ? fileEntry->getName().str() : "<built-in>";
+    }
+    m_fileIndices[fileID] = m_files.size();
+    m_files.push_back({fileName, {}, 0});
+    return m_files.back();
+}
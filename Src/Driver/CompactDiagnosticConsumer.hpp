@@ -0,0 +1,68 @@
+/**
+  * @file: CompactDiagnosticConsumer.hpp
+  * @brief: The CompactDiagnosticConsumer counts the diagnostics of a translation unit by category and keeps only the
+  *         first few messages of each file. Cross-target sysroots easily produce thousands of errors, Formatting and
+  *         printing each of them with its source snippet costs more than the parse itself
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef COMPACT_DIAGNOSTIC_CONSUMER_HPP_
+#define COMPACT_DIAGNOSTIC_CONSUMER_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/SourceLocation.h"
+
+class CompactDiagnosticConsumer : public clang::DiagnosticConsumer {
+public:
+
+    // messagesPerFile - Full messages kept for each file, Further diagnostics of the file are only counted
+    explicit CompactDiagnosticConsumer(const unsigned messagesPerFile = 3);
+    ~CompactDiagnosticConsumer() = default;
+    CompactDiagnosticConsumer& operator =(const CompactDiagnosticConsumer&) = delete;
+    CompactDiagnosticConsumer(const CompactDiagnosticConsumer&) = delete;
+
+    void HandleDiagnostic(clang::DiagnosticsEngine::Level level, const clang::Diagnostic& info) override;
+
+    // Compile of a translation unit is done, Print the summary to std::cerr at once and start over
+    void finish() override;
+
+private:
+    // Diagnostics of one file, In order of their first diagnostic
+    struct FileDiagnostics {
+        std::string fileName;
+        std::vector<std::string> messages;
+        unsigned dropped = 0;
+    };
+
+    // Entry of the file containing the location, Names are looked up once per file
+    FileDiagnostics& getFileDiagnostics(const clang::Diagnostic& info);
+
+    unsigned m_messagesPerFile = 0;
+
+    std::string m_mainFile;
+    std::vector<FileDiagnostics> m_files;
+    std::map<clang::FileID, std::size_t> m_fileIndices; // Index in m_files
+    std::map<std::string, unsigned> m_categoryCounts;
+    unsigned m_errors = 0;
+    unsigned m_warnings = 0;
+    bool m_lastKept = false; // Notes follow the diagnostic they belong to
+};
+
+#endif // COMPACT_DIAGNOSTIC_CONSUMER_HPP_
@@ -0,0 +1,77 @@
+/**
+  * @file: CostHistory.cpp
+  * @brief: The CostHistory keeps wall time and memory of each translation unit of previous batch runs in a local file.
+  *         Used to start expensive translation units first and to keep the memory of concurrent ones within a budget
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <tuple>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "CostHistory.hpp"
+#include "DriverUtilities.hpp"
+
+CostHistory::CostHistory(const std::string& historyFile)
+    : m_historyFile(historyFile) {
+}
+
+void CostHistory::load() {
+    m_costs.clear();
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(m_historyFile);
+    if(! buffer) {
+        return;
+    }
+
+    llvm::SmallVector<llvm::StringRef, 1024> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, false);
+    for(const auto& each : lines) {
+        llvm::StringRef wallTime, memory, fileName;
+        std::tie(wallTime, fileName) = each.split(' ');
+        std::tie(memory, fileName) = fileName.split(' ');
+
+        TranslationUnitCost cost;
+        if(wallTime.getAsInteger(10, cost.wallTime) || memory.getAsInteger(10, cost.memory) || fileName.empty()) {
+            m_costs.clear();
+            return;
+        }
+        m_costs[fileName] = cost;
+    }
+}
+
+bool CostHistory::save() const {
+    std::string content;
+    for(const auto& each : m_costs) {
+        content.append(std::to_string(each.second.wallTime) + " " + std::to_string(each.second.memory) + " " +
+                       each.first + "\n");
+    }
+    return DriverUtilities::writeFileAtomically(m_historyFile, content);
+}
+
+bool CostHistory::getCost(const std::string& fileName, TranslationUnitCost& cost) const {
+    const auto itr = m_costs.find(fileName);
+    if(m_costs.end() == itr) {
+        return false;
+    }
+    cost = itr->second;
+    return true;
+}
+
+void CostHistory::setCost(const std::string& fileName, const TranslationUnitCost& cost) {
+    m_costs[fileName] = cost;
+}
@@ -0,0 +1,64 @@
+/**
+  * @file: CostHistory.hpp
+  * @brief: The CostHistory keeps wall time and memory of each translation unit of previous batch runs in a local file.
+  *         Used to start expensive translation units first and to keep the memory of concurrent ones within a budget
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Format: One line per translation unit, "<wall time in ms> <memory in bytes> <source file>"
+
+#ifndef COST_HISTORY_HPP_
+#define COST_HISTORY_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Cost of one translation unit
+struct TranslationUnitCost {
+    uint64_t wallTime = 0; // Milliseconds
+    uint64_t memory = 0; // Bytes
+};
+
+class CostHistory {
+public:
+    explicit CostHistory(const std::string& historyFile);
+    ~CostHistory() = default;
+    CostHistory& operator =(const CostHistory&) = delete;
+    CostHistory(const CostHistory&) = delete;
+
+    // Read the history file, A missing or corrupted file gives an empty history
+    void load();
+
+    // Write the history file, Returns false on failure
+    bool save() const;
+
+    /** Get cost
+     * @arg fileName: Source file
+     * @arg cost: Receives the recorded cost
+     * @return bool: false when the translation unit was never recorded
+     */
+    bool getCost(const std::string& fileName, TranslationUnitCost& cost) const;
+
+    // Record the cost of a translation unit, Replaces the previous record
+    void setCost(const std::string& fileName, const TranslationUnitCost& cost);
+
+private:
+    std::string m_historyFile;
+    std::map<std::string, TranslationUnitCost> m_costs;
+};
+
+#endif // COST_HISTORY_HPP_
@@ -0,0 +1,337 @@
+/**
+  * @file: DaemonServer.cpp
+  * @brief: The DaemonServer keeps AutoDepMocker running and serves mock generation requests over a Unix domain socket.
+  *         File status and contents of headers and PCH container operations stay warm between requests.
+  *         Also contains the client which forwards a request of the command line to a running server
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "clang/Tooling/ArgumentsAdjusters.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "CompactDiagnosticConsumer.hpp"
+#include "DaemonServer.hpp"
+#include "DriverUtilities.hpp"
+#include "CustomFrontendAction.hpp"
+#include "SingleCommandDatabase.hpp"
+#include "StringPool.hpp"
+
+namespace {
+
+// A client which stops sending must not block the requests of all other clients
+const time_t requestTimeoutSeconds = 10;
+const std::size_t maximumRequestSize = 1 << 20;
+
+// Open a stream socket, Returns -1 on failure
+int openSocket(const std::string& socketPath, sockaddr_un& address) {
+    if(socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << socketPath << std::endl;
+        return -1;
+    }
+
+    address = {};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    return ::socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+// Remove the socket of a previous server which is gone, Returns false when the path must not be taken over
+bool removeStaleSocket(const std::string& socketPath, const sockaddr_un& address) {
+    struct stat status;
+    if(::lstat(socketPath.c_str(), &status) < 0) {
+        return ENOENT == errno;
+    }
+    if(! S_ISSOCK(status.st_mode)) {
+        std::cerr << socketPath << " exists and is not a socket" << std::endl;
+        return false;
+    }
+
+    // Only a socket nobody listens on refuses the connection
+    const int probeFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(probeFd < 0) {
+        return false;
+    }
+    const bool connected = (0 == ::connect(probeFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)));
+    const int connectError = errno;
+    ::close(probeFd);
+    if(connected) {
+        std::cerr << "A server is already listening on " << socketPath << std::endl;
+        return false;
+    }
+    if(ECONNREFUSED != connectError) {
+        std::cerr << "Unable to check socket " << socketPath << ": " << std::strerror(connectError) << std::endl;
+        return false;
+    }
+    return 0 == ::unlink(socketPath.c_str());
+}
+
+}
+
+DaemonServer::DaemonServer(const std::string& socketPath, const ParserSettings& settings,
+                           const std::string& preambleCacheDirectory, const SysrootImage* sysrootImage)
+    : m_socketPath(socketPath)
+    , m_settings(settings)
+    , m_fileSystem(llvm::vfs::createPhysicalFileSystem().release())
+    , m_pchContainerOps(std::make_shared<clang::PCHContainerOperations>()) {
+
+    // Nobody can answer questions of a background server
+    m_settings.askInteractiveMode = false;
+    m_settings.printGenerationBanner = false;
+
+    if(sysrootImage) {
+        m_fileSystem = sysrootImage->createFileSystem(m_fileSystem);
+    }
+
+    if(! preambleCacheDirectory.empty()) {
+        m_preambleCache = std::make_unique<PreambleCache>(preambleCacheDirectory);
+    }
+}
+
+DaemonServer::~DaemonServer() {
+    if(m_listenFd >= 0) {
+        ::close(m_listenFd);
+    }
+
+    // Socket is removed only while it is still the one bound by this server
+    struct stat status;
+    if(m_socketBound && (0 == ::lstat(m_socketPath.c_str(), &status)) && S_ISSOCK(status.st_mode) &&
+       (status.st_dev == m_socketDevice) && (status.st_ino == m_socketInode)) {
+        ::unlink(m_socketPath.c_str());
+    }
+}
+
+int DaemonServer::run() {
+    sockaddr_un address;
+    m_listenFd = openSocket(m_socketPath, address);
+    if(m_listenFd < 0) {
+        std::cerr << "Unable to create socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    if(! removeStaleSocket(m_socketPath, address)) {
+        std::cerr << "Unable to listen on " << m_socketPath << std::endl;
+        return 1;
+    }
+    if(::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "Unable to bind " << m_socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    struct stat status;
+    if(0 == ::lstat(m_socketPath.c_str(), &status)) {
+        m_socketBound = true;
+        m_socketDevice = status.st_dev;
+        m_socketInode = status.st_ino;
+    }
+    if(::listen(m_listenFd, SOMAXCONN) < 0) {
+        std::cerr << "Unable to listen on " << m_socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    // Clients might hang up before reading the response
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "\33[1;35mAutoDepMocker daemon is listening on " << m_socketPath << "\033[0m" << std::endl;
+
+    // Requests are handled one after another, Mock generation changes the working directory of the process
+    while(true) {
+        const int clientFd = ::accept(m_listenFd, nullptr, nullptr);
+        if(clientFd < 0) {
+            if(EINTR == errno) {
+                continue;
+            }
+            std::cerr << "Unable to accept connection: " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+
+        // Reads and writes give up after the timeout, So a stalled client delays the next one only that long
+        const timeval timeout = {requestTimeoutSeconds, 0};
+        ::setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        const std::vector<std::string> request = readRequest(clientFd);
+        if(! request.empty() && ("SHUTDOWN" == request.front())) {
+            DriverUtilities::writeAll(clientFd, "OK 0\n");
+            ::close(clientFd);
+            break;
+        }
+
+        DriverUtilities::writeAll(clientFd, handleRequest(request) + "\n");
+        ::close(clientFd);
+
+        // Mock model of the request is gone, So its strings are dropped instead of piling up over the requests
+        StringPool::reset();
+    }
+
+    return 0;
+}
+
+std::string DaemonServer::handleRequest(const std::vector<std::string>& requestFields) {
+    // GENERATE, working directory, source file and at least one argument
+    if((requestFields.size() < 4) || ("GENERATE" != requestFields.front())) {
+        return "ERROR malformed request";
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const std::string& workingDirectory = requestFields[1];
+    llvm::SmallString<256> absoluteSourcePath(requestFields[2]);
+    llvm::sys::fs::make_absolute(workingDirectory, absoluteSourcePath);
+    const std::string sourceFile = absoluteSourcePath.str();
+
+    // Mock files are generated to ./GeneratedMocks of the client's working directory
+    if(llvm::sys::fs::set_current_path(workingDirectory)) {
+        return "ERROR invalid working directory " + workingDirectory;
+    }
+
+    const std::vector<std::string> commandLine(requestFields.begin() + 3, requestFields.end());
+    const clang::tooling::CompileCommand command(workingDirectory, sourceFile, commandLine, "");
+    SingleCommandDatabase compilations(command);
+
+    // Preamble files are written before revalidation, So the cache never serves their stale size
+    std::vector<std::string> preambleArguments;
+    if(m_preambleCache) {
+        preambleArguments = m_preambleCache->prepare(command);
+    }
+
+    // Only entries of files changed since the last request are dropped, Unchanged headers stay warm
+    m_fileCache.revalidate(*m_fileSystem);
+
+    // The main file is the one being edited between requests, So it is read again every time and handed to clang
+    // as a remapped buffer instead of going through the cache
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> sourceContent = llvm::MemoryBuffer::getFile(sourceFile);
+    if(! sourceContent) {
+        return "ERROR unable to read " + sourceFile;
+    }
+
+    // A new file manager per request on top of the warm cache. ClangTool sets the working directory of the request
+    // on the file system
+    clang::tooling::ClangTool tool(compilations, {sourceFile}, m_pchContainerOps, m_fileCache.createFileSystem(m_fileSystem));
+    tool.mapVirtualFile(sourceFile, (*sourceContent)->getBuffer());
+    if(! preambleArguments.empty()) {
+        tool.appendArgumentsAdjuster(clang::tooling::getInsertArgumentAdjuster(preambleArguments,
+                                     clang::tooling::ArgumentInsertPosition::END));
+    }
+    CompactDiagnosticConsumer diagnosticConsumer;
+    if(m_settings.compactDiagnostics) {
+        tool.setDiagnosticConsumer(&diagnosticConsumer);
+    }
+    CustomFrontendActionFactory actionFactory(m_settings);
+    const int result = tool.run(&actionFactory);
+
+    const auto wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    std::cout << sourceFile << " (" << wallTime.count() << " ms)" << std::endl;
+
+    if(result) {
+        return "ERROR failed to parse " + sourceFile;
+    }
+    return "OK " + std::to_string(wallTime.count());
+}
+
+std::vector<std::string> DaemonServer::readRequest(const int socketFd) {
+    std::string data;
+    char buffer[4096];
+
+    // Request is terminated by the end of stream, Clients shut down their sending side after the last field.
+    // A timed out or oversized request is dropped and answered as malformed
+    while(true) {
+        const ssize_t bytesRead = ::read(socketFd, buffer, sizeof(buffer));
+        if(bytesRead < 0) {
+            if(EINTR == errno) {
+                continue;
+            }
+            return {};
+        }
+        if(0 == bytesRead) {
+            break;
+        }
+        if((data.size() + bytesRead) > maximumRequestSize) {
+            return {};
+        }
+        data.append(buffer, bytesRead);
+    }
+
+    std::vector<std::string> fields;
+    std::size_t fieldStart = 0;
+    std::size_t fieldEnd = data.find('\0');
+    while(std::string::npos != fieldEnd) {
+        fields.push_back(data.substr(fieldStart, fieldEnd - fieldStart));
+        fieldStart = fieldEnd + 1;
+        fieldEnd = data.find('\0', fieldStart);
+    }
+
+    // Last field without terminator, Hand written requests like printf 'SHUTDOWN'
+    if(fieldStart < data.size()) {
+        fields.push_back(data.substr(fieldStart));
+    }
+    return fields;
+}
+
+int DaemonServer::sendRequest(const std::string& socketPath, const clang::tooling::CompileCommand& command) {
+    sockaddr_un address;
+    const int socketFd = openSocket(socketPath, address);
+    if(socketFd < 0) {
+        std::cerr << "Unable to create socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    if(::connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "Unable to connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(socketFd);
+        return 1;
+    }
+
+    std::string request;
+    for(const auto& each : {std::string("GENERATE"), command.Directory, command.Filename}) {
+        request.append(each);
+        request.push_back('\0');
+    }
+    for(const auto& each : command.CommandLine) {
+        request.append(each);
+        request.push_back('\0');
+    }
+
+    if(! DriverUtilities::writeAll(socketFd, request)) {
+        std::cerr << "Unable to send request: " << std::strerror(errno) << std::endl;
+        ::close(socketFd);
+        return 1;
+    }
+    ::shutdown(socketFd, SHUT_WR);
+
+    std::string response;
+    char buffer[256];
+    ssize_t bytesRead = 0;
+    while((bytesRead = ::read(socketFd, buffer, sizeof(buffer))) > 0) {
+        response.append(buffer, bytesRead);
+    }
+    ::close(socketFd);
+
+    std::cout << response;
+    return (0 == response.rfind("OK", 0)) ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/**
+  * @file: DaemonServer.hpp
+  * @brief: The DaemonServer keeps AutoDepMocker running and serves mock generation requests over a Unix domain socket.
+  *         File status and contents of headers and PCH container operations stay warm between requests.
+  *         Also contains the client which forwards a request of the command line to a running server
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Request format(one request per connection, each field terminated by a NUL character):
+// ------------------------------------------------------------------------------------
+// GENERATE
+// <working directory>
+// <source file>
+// <compile command argument 1>
+// ...
+// <compile command argument n>
+//
+// The request ends with the stream, So the client shuts down its sending side after the last field.
+// Arguments may be empty or contain new lines(-DVALUE=, "")
+// Requests are handled one after another. A request larger than 1 MiB or not completed within 10 seconds is answered
+// as malformed
+//
+// Response: "OK <milliseconds>" on success, "ERROR <reason>" otherwise
+// Request "SHUTDOWN" stops the server
+
+#ifndef DAEMON_SERVER_HPP_
+#define DAEMON_SERVER_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "clang/Frontend/PCHContainerOperations.h"
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+#include "ParserSettings.hpp"
+#include "PreambleCache.hpp"
+#include "SharedFileCache.hpp"
+#include "SysrootImage.hpp"
+
+class DaemonServer {
+public:
+
+    // preambleCacheDirectory - Keep preambles of requested sources precompiled in this directory, Empty disables it
+    // sysrootImage - Serve headers below the packed sysroot trees from the image, Must outlive the server
+    explicit DaemonServer(const std::string& socketPath, const ParserSettings& settings,
+                          const std::string& preambleCacheDirectory = "", const SysrootImage* sysrootImage = nullptr);
+    ~DaemonServer();
+    DaemonServer& operator =(const DaemonServer&) = delete;
+    DaemonServer(const DaemonServer&) = delete;
+
+    /** Run server
+     * @brief: Listen on the socket and handle requests one after another until SHUTDOWN is received
+     * @return int: 0 on regular shutdown, 1 when the socket can not be created or another server listens on it
+     */
+    int run();
+
+    /** Send request
+     * @brief: Client side, Forward the compile command of the given source file to a running server
+     * @arg socketPath: Socket the server listens on
+     * @arg command: Compile command of the translation unit
+     * @return int: 0 when the server generated mocks, 1 otherwise
+     */
+    static int sendRequest(const std::string& socketPath, const clang::tooling::CompileCommand& command);
+
+private:
+    // Parse request and generate mocks, Returns response line
+    std::string handleRequest(const std::vector<std::string>& requestFields);
+
+    // Read NUL terminated fields from the socket until end of stream, Empty when the request times out or is too large
+    static std::vector<std::string> readRequest(const int socketFd);
+
+    std::string m_socketPath;
+    ParserSettings m_settings;
+    int m_listenFd = -1;
+
+    // Identity of the socket file bound by this server, A socket of another server at the same path is never removed
+    bool m_socketBound = false;
+    dev_t m_socketDevice = 0;
+    ino_t m_socketInode = 0;
+
+    // Warm state shared by all requests. The cache is keyed by absolute path and outlives the file manager of a
+    // request, Which resolves relative names against the working directory of its client
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> m_fileSystem;
+    SharedFileCache m_fileCache;
+    std::shared_ptr<clang::PCHContainerOperations> m_pchContainerOps;
+    std::unique_ptr<PreambleCache> m_preambleCache;
+};
+
+#endif // DAEMON_SERVER_HPP_
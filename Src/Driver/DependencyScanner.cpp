@@ -0,0 +1,93 @@
+/**
+  * @file: DependencyScanner.cpp
+  * @brief: The DependencyScanner lists the files a translation unit reaches without parsing it. Sources are
+  *         minimized to their preprocessor directives and only preprocessed, Which is a small fraction of a full parse
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+
+#include "clang/Tooling/DependencyScanning/DependencyScanningWorker.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Path.h"
+
+#include "DependencyScanner.hpp"
+#include "SingleCommandDatabase.hpp"
+
+DependencyScanner::DependencyScanner()
+    : m_service(clang::tooling::dependencies::ScanningMode::MinimizedSourcePreprocessing) {
+}
+
+bool DependencyScanner::scan(const clang::tooling::CompileCommand& command, std::vector<std::string>& files) {
+    files.clear();
+
+    // Workers keep a file manager of their own and are cheap, The expensive minimized files live in the service
+    clang::tooling::dependencies::DependencyScanningWorker worker(m_service);
+    SingleCommandDatabase compilations(command);
+    llvm::Expected<std::string> dependencyFile =
+        worker.getDependencyFile(command.Filename, command.Directory, compilations);
+    if(! dependencyFile) {
+        llvm::consumeError(dependencyFile.takeError());
+        return false;
+    }
+
+    files = parseDependencyFile(*dependencyFile, command.Directory);
+    return ! files.empty();
+}
+
+std::vector<std::string> DependencyScanner::parseDependencyFile(llvm::StringRef content, llvm::StringRef directory) {
+    std::vector<std::string> files;
+    std::string path;
+    bool targetSeen = false;
+
+    const auto addPath = [&]() {
+        if(path.empty()) {
+            return;
+        }
+        llvm::SmallString<256> absolutePath(path);
+        if(! llvm::sys::path::is_absolute(absolutePath)) {
+            absolutePath = directory;
+            llvm::sys::path::append(absolutePath, path);
+        }
+        llvm::sys::path::remove_dots(absolutePath, true);
+        files.push_back(absolutePath.str());
+        path.clear();
+    };
+
+    for(std::size_t i = 0; i < content.size(); i++) {
+        const char current = content[i];
+        const char next = (i + 1 < content.size()) ? content[i + 1] : '\0';
+        if(('\\' == current) && (' ' == next)) {
+            path.push_back(' '); // Escaped space inside a path
+            ++i;
+        } else if(('\\' == current) && ('\n' == next)) {
+            addPath(); // Line continuation
+            ++i;
+        } else if((' ' == current) || ('\t' == current) || ('\n' == current)) {
+            addPath();
+        } else if((':' == current) && ! targetSeen && ((' ' == next) || ('\n' == next) || ('\0' == next))) {
+            path.clear(); // Target of the rule
+            targetSeen = true;
+        } else {
+            path.push_back(current);
+        }
+    }
+    addPath();
+
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
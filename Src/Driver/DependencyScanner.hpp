@@ -0,0 +1,54 @@
+/**
+  * @file: DependencyScanner.hpp
+  * @brief: The DependencyScanner lists the files a translation unit reaches without parsing it. Sources are
+  *         minimized to their preprocessor directives and only preprocessed, Which is a small fraction of a full parse
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef DEPENDENCY_SCANNER_HPP_
+#define DEPENDENCY_SCANNER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+#include "clang/Tooling/DependencyScanning/DependencyScanningService.h"
+#include "llvm/ADT/StringRef.h"
+
+class DependencyScanner {
+public:
+    explicit DependencyScanner();
+    ~DependencyScanner() = default;
+    DependencyScanner& operator =(const DependencyScanner&) = delete;
+    DependencyScanner(const DependencyScanner&) = delete;
+
+    /** Scan
+     * @brief: Preprocess the minimized sources of the translation unit, Thread-safe.
+     *         Minimized files are shared by all scans, So headers common to many translation units are read once
+     * @arg command: Compile command of the translation unit
+     * @arg files: Receives the absolute paths of the main file and every reached header, sorted
+     * @return bool: false when preprocessing failed(e.g. missing header), files is left empty then
+     */
+    bool scan(const clang::tooling::CompileCommand& command, std::vector<std::string>& files);
+
+    // Paths of a make dependency file("target: dep1 dep2 \\\n dep3"), Relative paths are made absolute to directory
+    static std::vector<std::string> parseDependencyFile(llvm::StringRef content, llvm::StringRef directory);
+
+private:
+    clang::tooling::dependencies::DependencyScanningService m_service;
+};
+
+#endif // DEPENDENCY_SCANNER_HPP_
@@ -0,0 +1,136 @@
+/**
+  * @file: DriverUtilities.cpp
+  * @brief: Helper functions shared by the drivers(batch, daemon, caches) of AutoDepMocker
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+
+#include <unistd.h>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Threading.h"
+
+#include "DriverUtilities.hpp"
+
+std::string DriverUtilities::computeHash(const std::vector<llvm::StringRef>& contents) {
+    llvm::MD5 hash;
+    for(const auto& each : contents) {
+        hash.update(each);
+        hash.update(llvm::StringRef("\0", 1));
+    }
+
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    return result.digest().str();
+}
+
+std::string DriverUtilities::getAbsoluteSourcePath(const clang::tooling::CompileCommand& command) {
+    llvm::SmallString<256> absolutePath(command.Filename);
+    llvm::sys::fs::make_absolute(command.Directory, absolutePath);
+    llvm::sys::path::remove_dots(absolutePath, true);
+    return absolutePath.str();
+}
+
+bool DriverUtilities::isSourceArgument(const clang::tooling::CompileCommand& command, const std::string& argument) {
+    if(argument == command.Filename) {
+        return true;
+    }
+    if(argument.empty() || ('-' == argument.front())) {
+        return false;
+    }
+
+    // Source file might be given relative in the command line and absolute in the compile command or vice versa
+    llvm::SmallString<256> absolutePath(argument);
+    llvm::sys::fs::make_absolute(command.Directory, absolutePath);
+    llvm::sys::path::remove_dots(absolutePath, true);
+    return absolutePath.str() == getAbsoluteSourcePath(command);
+}
+
+std::vector<std::string> DriverUtilities::getCompileFlags(const clang::tooling::CompileCommand& command) {
+    std::vector<std::string> flags;
+    for(std::size_t i = 1; i < command.CommandLine.size(); i++) {
+        if(! isSourceArgument(command, command.CommandLine[i])) {
+            flags.push_back(command.CommandLine[i]);
+        }
+    }
+    return flags;
+}
+
+clang::tooling::CompileCommand DriverUtilities::replaceSourceFile(const clang::tooling::CompileCommand& command, const std::string& fileName) {
+    clang::tooling::CompileCommand result = command;
+    result.Filename = fileName;
+
+    bool replaced = false;
+    for(std::size_t i = 1; i < result.CommandLine.size(); i++) {
+        if(isSourceArgument(command, result.CommandLine[i])) {
+            result.CommandLine[i] = fileName;
+            replaced = true;
+        }
+    }
+    if(! replaced) {
+        result.CommandLine.push_back(fileName);
+    }
+    return result;
+}
+
+bool DriverUtilities::createDirectories(const std::string& directory) {
+    if(const std::error_code error = llvm::sys::fs::create_directories(directory)) {
+        std::cerr << "Unable to create directory " << directory << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DriverUtilities::writeFileAtomically(const std::string& fileName, const std::string& content) {
+    const std::string temporaryFileName = fileName + ".tmp" + std::to_string(::getpid()) + "." +
+                                          std::to_string(llvm::get_threadid());
+    {
+        // Buffered data is written by close(), A full disk shows only then
+        std::ofstream file(temporaryFileName, std::ios::trunc);
+        file << content;
+        file.close();
+        if(file.fail()) {
+            llvm::sys::fs::remove(temporaryFileName);
+            return false;
+        }
+    }
+    if(llvm::sys::fs::rename(temporaryFileName, fileName)) {
+        llvm::sys::fs::remove(temporaryFileName);
+        return false;
+    }
+    return true;
+}
+
+bool DriverUtilities::writeAll(const int fd, const std::string& data) {
+    std::size_t written = 0;
+    while(written < data.size()) {
+        const ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+        if(result < 0) {
+            if(EINTR == errno) {
+                continue;
+            }
+            return false;
+        }
+        written += result;
+    }
+    return true;
+}
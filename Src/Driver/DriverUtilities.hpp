@@ -0,0 +1,58 @@
+/**
+  * @file: DriverUtilities.hpp
+  * @brief: Helper functions shared by the drivers(batch, daemon, caches) of AutoDepMocker
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef DRIVER_UTILITIES_HPP_
+#define DRIVER_UTILITIES_HPP_
+
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/ADT/StringRef.h"
+
+// Basic utilities shared by the drivers
+class DriverUtilities {
+public:
+
+    // Hex encoded MD5 of the given strings, Strings are separated so that ("ab", "c") and ("a", "bc") differ
+    static std::string computeHash(const std::vector<llvm::StringRef>& contents);
+
+    // Absolute path of the source file of the compile command
+    static std::string getAbsoluteSourcePath(const clang::tooling::CompileCommand& command);
+
+    // true when the command line argument names the source file of the compile command
+    static bool isSourceArgument(const clang::tooling::CompileCommand& command, const std::string& argument);
+
+    // Compile command arguments without the compiler and the source file, Identifies the flag set of a translation unit
+    static std::vector<std::string> getCompileFlags(const clang::tooling::CompileCommand& command);
+
+    // Compile command which compiles the given file with the flags of the given compile command
+    static clang::tooling::CompileCommand replaceSourceFile(const clang::tooling::CompileCommand& command, const std::string& fileName);
+
+    // Create directory and its parents, Returns false on failure
+    static bool createDirectories(const std::string& directory);
+
+    // Write to a temporary file and rename it, Other processes never see partially written files
+    static bool writeFileAtomically(const std::string& fileName, const std::string& content);
+
+    // Write all data to the socket or pipe, Retries on interrupts. Returns false on failure
+    static bool writeAll(const int fd, const std::string& data);
+};
+
+#endif // DRIVER_UTILITIES_HPP_
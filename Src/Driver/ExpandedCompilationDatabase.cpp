@@ -0,0 +1,194 @@
+/**
+  * @file: ExpandedCompilationDatabase.cpp
+  * @brief: Compilation database which expands @response files of the compile commands of another database and drops
+  *         repeated include and macro flags. Argument lists are stored once, Translation units with identical flags share them
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <set>
+#include <utility>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/StringSaver.h"
+
+#include "DriverUtilities.hpp"
+#include "ExpandedCompilationDatabase.hpp"
+
+namespace {
+
+// Options whose value is an include directory, Longer names first so that no option is taken for the prefix of another
+const char* const includeOptions[] = {"-idirafter", "-isystem", "-iquote", "-I"};
+
+// Options whose value defines or undefines a macro
+const char* const macroOptions[] = {"-D", "-U"};
+
+/** Split option
+ * @brief: Match the argument at index against the option, Joined("-I/a") and separate("-I /a") values
+ * @arg arguments: Command line
+ * @arg index: Argument to be matched, Advanced to the value when the value is separate
+ * @arg option: Option name
+ * @arg value: Receives the value
+ * @return bool: true when the argument is the option
+ */
+bool splitOption(const std::vector<std::string>& arguments, std::size_t& index, llvm::StringRef option, std::string& value) {
+    llvm::StringRef argument(arguments[index]);
+    if(! argument.consume_front(option)) {
+        return false;
+    }
+    if(! argument.empty()) {
+        // Another option starting with the same name(e.g. -isystem-after)
+        if('-' == argument.front()) {
+            return false;
+        }
+        value = argument;
+        return true;
+    }
+    if(index + 1 >= arguments.size()) {
+        return false; // Value is missing, Left to the compiler to complain
+    }
+    value = arguments[++index];
+    return true;
+}
+
+}
+
+constexpr std::size_t ExpandedCompilationDatabase::noSource;
+
+ExpandedCompilationDatabase::ExpandedCompilationDatabase(const clang::tooling::CompilationDatabase& underlying)
+    : m_underlying(underlying) {
+}
+
+std::vector<clang::tooling::CompileCommand> ExpandedCompilationDatabase::getCompileCommands(llvm::StringRef filePath) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto itr = m_commands.find(filePath);
+    if(m_commands.end() == itr) {
+        std::vector<StoredCommand> storedCommands;
+        for(const auto& each : m_underlying.getCompileCommands(filePath)) {
+            storedCommands.push_back(store(each));
+        }
+        itr = m_commands.emplace(filePath, std::move(storedCommands)).first;
+    }
+
+    std::vector<clang::tooling::CompileCommand> compileCommands;
+    for(const auto& each : itr->second) {
+        compileCommands.push_back(toCompileCommand(each));
+    }
+    return compileCommands;
+}
+
+std::vector<std::string> ExpandedCompilationDatabase::getAllFiles() const {
+    return m_underlying.getAllFiles();
+}
+
+std::vector<clang::tooling::CompileCommand> ExpandedCompilationDatabase::getAllCompileCommands() const {
+    std::vector<clang::tooling::CompileCommand> compileCommands = m_underlying.getAllCompileCommands();
+    for(auto& each : compileCommands) {
+        each.CommandLine = expandArguments(each.CommandLine, each.Directory);
+    }
+    return compileCommands;
+}
+
+std::vector<std::string> ExpandedCompilationDatabase::expandArguments(const std::vector<std::string>& commandLine,
+                                                                      const std::string& directory) {
+    // Response files are named relative to the working directory of the compile, Not to the one of AutoDepMocker
+    llvm::BumpPtrAllocator allocator;
+    llvm::StringSaver saver(allocator);
+    llvm::SmallVector<const char*, 256> expanded;
+    for(const auto& each : commandLine) {
+        if((each.size() > 1) && ('@' == each.front())) {
+            llvm::SmallString<256> responseFile(llvm::StringRef(each).drop_front());
+            llvm::sys::fs::make_absolute(directory, responseFile);
+            expanded.push_back(saver.save("@" + responseFile.str()).data());
+        } else {
+            expanded.push_back(each.c_str());
+        }
+    }
+    llvm::cl::ExpandResponseFiles(saver, llvm::cl::TokenizeGNUCommandLine, expanded, false, true);
+    const std::vector<std::string> arguments(expanded.begin(), expanded.end());
+
+    // An include directory given again is ignored by the compiler, A macro set again to the same value changes nothing.
+    // Anything else is kept as it is, Including the compiler at the front
+    std::set<std::pair<std::string, std::string>> includeDirectories;
+    std::map<std::string, std::string> macroStates; // Last -D or -U of each macro name
+    std::vector<std::string> result;
+    result.reserve(arguments.size());
+    for(std::size_t i = 0; i < arguments.size(); i++) {
+        const std::size_t first = i;
+        std::string value;
+        bool repeated = false;
+        bool matched = false;
+
+        for(const char* option : includeOptions) {
+            if((first > 0) && splitOption(arguments, i, option, value)) {
+                repeated = ! includeDirectories.emplace(option, value).second;
+                matched = true;
+                break;
+            }
+        }
+        for(const char* option : macroOptions) {
+            if(! matched && (first > 0) && splitOption(arguments, i, option, value)) {
+                const std::string name = llvm::StringRef(value).split('=').first;
+                const std::string state = option + value;
+                repeated = (macroStates[name] == state);
+                macroStates[name] = state;
+                break;
+            }
+        }
+
+        if(! repeated) {
+            result.insert(result.end(), arguments.begin() + first, arguments.begin() + i + 1);
+        }
+    }
+    return result;
+}
+
+ExpandedCompilationDatabase::StoredCommand ExpandedCompilationDatabase::store(const clang::tooling::CompileCommand& command) const {
+    std::vector<std::string> commandLine = expandArguments(command.CommandLine, command.Directory);
+
+    // Without the source file, Translation units compiled with the same flags get the same argument list
+    std::size_t sourceIndex = noSource;
+    std::string sourceArgument;
+    for(std::size_t i = 1; i < commandLine.size(); i++) {
+        if(DriverUtilities::isSourceArgument(command, commandLine[i])) {
+            sourceIndex = i;
+            sourceArgument = std::move(commandLine[i]);
+            commandLine.erase(commandLine.begin() + i);
+            break;
+        }
+    }
+
+    const std::string sourcePosition = std::to_string(sourceIndex);
+    std::vector<llvm::StringRef> keyContents = {command.Directory, sourcePosition};
+    keyContents.insert(keyContents.end(), commandLine.begin(), commandLine.end());
+    std::shared_ptr<const std::vector<std::string>>& sharedCommandLine = m_commandLines[DriverUtilities::computeHash(keyContents)];
+    if(! sharedCommandLine) {
+        sharedCommandLine = std::make_shared<const std::vector<std::string>>(std::move(commandLine));
+    }
+    return {command.Directory, command.Filename, command.Output, sharedCommandLine, sourceArgument, sourceIndex};
+}
+
+clang::tooling::CompileCommand ExpandedCompilationDatabase::toCompileCommand(const StoredCommand& storedCommand) {
+    std::vector<std::string> commandLine = *storedCommand.commandLine;
+    if(noSource != storedCommand.sourceIndex) {
+        commandLine.insert(commandLine.begin() + storedCommand.sourceIndex, storedCommand.sourceArgument);
+    }
+    return clang::tooling::CompileCommand(storedCommand.directory, storedCommand.fileName, std::move(commandLine),
+                                          storedCommand.output);
+}
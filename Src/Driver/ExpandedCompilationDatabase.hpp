@@ -0,0 +1,85 @@
+/**
+  * @file: ExpandedCompilationDatabase.hpp
+  * @brief: Compilation database which expands @response files of the compile commands of another database and drops
+  *         repeated include and macro flags. Argument lists are stored once, Translation units with identical flags share them
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef EXPANDED_COMPILATION_DATABASE_HPP_
+#define EXPANDED_COMPILATION_DATABASE_HPP_
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+class ExpandedCompilationDatabase : public clang::tooling::CompilationDatabase {
+public:
+
+    // underlying - Database the compile commands are taken from, Must outlive this database
+    explicit ExpandedCompilationDatabase(const clang::tooling::CompilationDatabase& underlying);
+    ~ExpandedCompilationDatabase() = default;
+    ExpandedCompilationDatabase& operator =(const ExpandedCompilationDatabase&) = delete;
+    ExpandedCompilationDatabase(const ExpandedCompilationDatabase&) = delete;
+
+    // Compile commands of the file with expanded arguments, Computed once per file. Thread safe
+    std::vector<clang::tooling::CompileCommand> getCompileCommands(llvm::StringRef filePath) const override;
+
+    std::vector<std::string> getAllFiles() const override;
+
+    std::vector<clang::tooling::CompileCommand> getAllCompileCommands() const override;
+
+    /** Expand arguments
+     * @brief: Replace @response files by their content(GNU quoting, nested files relative to the including one) and
+     *         drop include directories and macro definitions which have no effect because they repeat earlier ones.
+     *         Order of the remaining arguments is kept
+     * @arg commandLine: Compiler followed by its arguments
+     * @arg directory: Working directory of the compile, Response files are relative to it
+     * @return: Expanded command line
+     */
+    static std::vector<std::string> expandArguments(const std::vector<std::string>& commandLine, const std::string& directory);
+
+private:
+    static constexpr std::size_t noSource = std::numeric_limits<std::size_t>::max();
+
+    // Compile command whose argument list is shared with other compile commands,
+    // The source file is put into the argument list when the compile command is handed out
+    struct StoredCommand {
+        std::string directory;
+        std::string fileName;
+        std::string output;
+        std::shared_ptr<const std::vector<std::string>> commandLine;
+        std::string sourceArgument; // Source file as written in the command line
+        std::size_t sourceIndex = noSource; // Position of sourceArgument in the command line
+    };
+
+    // Store the compile command with its expanded arguments, Caller holds the mutex
+    StoredCommand store(const clang::tooling::CompileCommand& command) const;
+
+    static clang::tooling::CompileCommand toCompileCommand(const StoredCommand& storedCommand);
+
+    const clang::tooling::CompilationDatabase& m_underlying;
+
+    mutable std::mutex m_mutex;
+    mutable std::map<std::string, std::vector<StoredCommand>> m_commands; // Key is the requested file path
+    mutable std::map<std::string, std::shared_ptr<const std::vector<std::string>>> m_commandLines; // Key is hash of arguments
+};
+
+#endif // EXPANDED_COMPILATION_DATABASE_HPP_
@@ -0,0 +1,228 @@
+/**
+  * @file: ForkServer.cpp
+  * @brief: The ForkServer runs each translation unit of a batch in a child process forked from the driver process.
+  *         Children share everything the driver loaded(compilation database, precompiled header arguments, sysroot image,
+  *         caches) copy-on-write, While global state of the frontend never leaks from one translation unit to the next
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "DriverUtilities.hpp"
+#include "ForkServer.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+// Running child and the data it sent so far
+struct Child {
+    pid_t pid = -1;
+    int fd = -1;
+    std::size_t index = 0;
+    std::string data;
+    std::chrono::steady_clock::time_point killTime = std::chrono::steady_clock::time_point::max();
+};
+
+// Time a child gets beyond the time limit to stop by itself and send its partial result
+const std::chrono::seconds gracePeriod(10);
+
+// Reap the child, Returns true when it exited on its own with status 0
+bool waitForChild(const pid_t pid) {
+    int status = 0;
+    while(::waitpid(pid, &status, 0) < 0) {
+        if(EINTR != errno) {
+            return false;
+        }
+    }
+    return WIFEXITED(status) && (0 == WEXITSTATUS(status));
+}
+
+// Bytes of address space of the calling process, 0 when unknown
+std::size_t getAddressSpaceSize() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t pages = 0;
+    if(! (statm >> pages)) {
+        return 0;
+    }
+    return pages * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+// Limits enforced by the kernel, Called in the child. The parser checks its limits only between top-level
+// declarations and measures only the AST, These limits hold for the whole process at any time
+void limitChild(const std::chrono::milliseconds timeLimit, const std::size_t memoryLimit) {
+    if(timeLimit.count()) {
+        // SIGXCPU at the soft limit ends the child, SIGKILL at the hard limit if it is handled
+        const rlim_t seconds = std::chrono::duration_cast<std::chrono::seconds>(timeLimit + gracePeriod).count() + 1;
+        const rlimit cpuLimit = {seconds, seconds + 1};
+        ::setrlimit(RLIMIT_CPU, &cpuLimit);
+    }
+
+    // The child starts with the address space of the driver, Only its growth is limited
+    const std::size_t inherited = memoryLimit ? getAddressSpaceSize() : 0;
+    if(inherited) {
+        const rlimit memory = {inherited + memoryLimit, inherited + memoryLimit};
+        ::setrlimit(RLIMIT_AS, &memory);
+    }
+}
+
+}
+
+ForkServer::ForkServer(const unsigned jobs)
+    : m_jobs(jobs ? jobs : 1) {
+}
+
+void ForkServer::setTimeLimit(const std::chrono::milliseconds timeLimit) {
+    m_timeLimit = timeLimit;
+}
+
+void ForkServer::setMemoryLimit(const std::size_t memoryLimit) {
+    m_memoryLimit = memoryLimit;
+}
+
+void ForkServer::run(BatchScheduler& scheduler, const TaskType& task, const CompletionType& completion) {
+    std::vector<Child> children;
+
+    while(true) {
+        // Start children as long as slots are free and the scheduler has work which can start now
+        while(children.size() < m_jobs) {
+            const std::size_t index = scheduler.tryAcquire();
+            if(BatchScheduler::noTranslationUnit == index) {
+                break;
+            }
+
+            int fds[2];
+            if(::pipe(fds) < 0) {
+                completion(index, false, "");
+                scheduler.release(index);
+                continue;
+            }
+
+            // Buffered output would be written by the driver and by the child otherwise
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+
+            const pid_t pid = ::fork();
+            if(0 == pid) {
+                ::close(fds[0]);
+                for(const auto& each : children) {
+                    ::close(each.fd);
+                }
+                limitChild(m_timeLimit, m_memoryLimit);
+                const bool written = DriverUtilities::writeAll(fds[1], task(index));
+                std::cout.flush();
+                std::cerr.flush();
+                Logger::flush();
+
+                // Destructors of the driver's objects must not run in the child
+                ::_exit(written ? 0 : 1);
+            }
+
+            ::close(fds[1]);
+            if(pid < 0) {
+                ::close(fds[0]);
+                completion(index, false, "");
+                scheduler.release(index);
+                continue;
+            }
+            Child child;
+            child.pid = pid;
+            child.fd = fds[0];
+            child.index = index;
+            if(m_timeLimit.count()) {
+                child.killTime = std::chrono::steady_clock::now() + m_timeLimit + gracePeriod;
+            }
+            children.push_back(std::move(child));
+        }
+
+        // Nothing runs, So the scheduler had nothing left either
+        if(children.empty()) {
+            break;
+        }
+
+        // Wake up in time to kill the next overdue child
+        std::vector<pollfd> pollFds;
+        auto nextKillTime = std::chrono::steady_clock::time_point::max();
+        for(const auto& each : children) {
+            pollFds.push_back({each.fd, POLLIN, 0});
+            nextKillTime = std::min(nextKillTime, each.killTime);
+        }
+        int timeout = -1;
+        if(std::chrono::steady_clock::time_point::max() != nextKillTime) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(nextKillTime - std::chrono::steady_clock::now());
+            timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(remaining.count(), 0));
+        }
+
+        const int ready = ::poll(pollFds.data(), pollFds.size(), timeout);
+        if(ready < 0) {
+            if(EINTR == errno) {
+                continue;
+            }
+            std::cerr << "Waiting for worker processes failed" << std::endl;
+            pollFds.clear();
+            for(const auto& each : children) {
+                pollFds.push_back({each.fd, POLLIN, POLLHUP}); // Read until the end of each child
+            }
+        }
+
+        // Killed children close their pipe, They are reaped below like every other child
+        const auto now = std::chrono::steady_clock::now();
+        for(auto& each : children) {
+            if(now >= each.killTime) {
+                std::cerr << "Worker process " << each.pid << " killed, Time limit exceeded" << std::endl;
+                ::kill(each.pid, SIGKILL);
+                each.killTime = std::chrono::steady_clock::time_point::max();
+            }
+        }
+
+        // Backwards, Finished children are removed while iterating
+        for(std::size_t i = pollFds.size(); i-- > 0;) {
+            if(0 == pollFds[i].revents) {
+                continue;
+            }
+
+            Child& child = children[i];
+            char buffer[65536];
+            const ssize_t bytesRead = ::read(child.fd, buffer, sizeof(buffer));
+            if(bytesRead > 0) {
+                child.data.append(buffer, bytesRead);
+                continue;
+            }
+            if((bytesRead < 0) && (EINTR == errno)) {
+                continue;
+            }
+
+            // End of stream, The child exited or died
+            ::close(child.fd);
+            const bool exited = waitForChild(child.pid);
+            completion(child.index, exited, std::move(child.data));
+            scheduler.release(child.index);
+            children.erase(children.begin() + i);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/**
+  * @file: ForkServer.hpp
+  * @brief: The ForkServer runs each translation unit of a batch in a child process forked from the driver process.
+  *         Children share everything the driver loaded(compilation database, precompiled header arguments, sysroot image,
+  *         caches) copy-on-write, While global state of the frontend never leaks from one translation unit to the next
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef FORK_SERVER_HPP_
+#define FORK_SERVER_HPP_
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "BatchScheduler.hpp"
+
+class ForkServer {
+public:
+
+    // Runs in the child, Returns the data sent back to the driver
+    using TaskType = std::function<std::string(const std::size_t index)>;
+
+    // Runs in the driver once the child is gone, exited is false when the child crashed or was killed
+    using CompletionType = std::function<void(const std::size_t index, const bool exited, std::string&& result)>;
+
+    // jobs - Number of children running at the same time
+    explicit ForkServer(const unsigned jobs);
+    ~ForkServer() = default;
+    ForkServer& operator =(const ForkServer&) = delete;
+    ForkServer(const ForkServer&) = delete;
+
+    /** Run
+     * @brief: Fork a child for every translation unit handed out by the scheduler and collect its result over a pipe.
+     *         Must be called while the process has no other threads, Forking copies only the calling thread
+     * @arg scheduler: Hands out the translation units
+     * @arg task: Processes one translation unit in the child
+     * @arg completion: Receives the result of one translation unit in the driver
+     */
+    void run(BatchScheduler& scheduler, const TaskType& task, const CompletionType& completion);
+
+    // Kill children running longer than the limit plus a grace period, 0 means unlimited.
+    // The parser stops by itself at the limit, The kill catches stalls it can not interrupt.
+    // CPU time of a child is limited by the kernel to the same time(RLIMIT_CPU)
+    void setTimeLimit(const std::chrono::milliseconds timeLimit);
+
+    // Bytes of address space a child may allocate beyond what it inherits from the driver, 0 means unlimited.
+    // Enforced by the kernel(RLIMIT_AS), Allocations beyond fail and the child ends like a crash
+    void setMemoryLimit(const std::size_t memoryLimit);
+
+private:
+    unsigned m_jobs = 0;
+    std::chrono::milliseconds m_timeLimit = {};
+    std::size_t m_memoryLimit = 0;
+};
+
+#endif // FORK_SERVER_HPP_
@@ -0,0 +1,235 @@
+/**
+  * @file: HeaderIndex.cpp
+  * @brief: The HeaderIndex knows the entries of every directory below the given root directories. Include lookups probe
+  *         each include directory in turn, Paths the index knows to be missing are answered without asking the file system.
+  *         The index is kept in a file and a directory is read again only when its modification time changed
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "HeaderIndex.hpp"
+
+namespace {
+
+const char* const formatHeader = "AutoDepMockerHeaderIndex 1\n";
+
+class HeaderIndexFileSystem : public llvm::vfs::FileSystem {
+public:
+    explicit HeaderIndexFileSystem(HeaderIndex& index, llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem)
+        : m_index(index)
+        , m_underlyingFileSystem(std::move(underlyingFileSystem)) {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override {
+        if(isMissing(path)) {
+            return std::make_error_code(std::errc::no_such_file_or_directory);
+        }
+        return m_underlyingFileSystem->status(path);
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine& path) override {
+        if(isMissing(path)) {
+            return std::make_error_code(std::errc::no_such_file_or_directory);
+        }
+        return m_underlyingFileSystem->openFileForRead(path);
+    }
+
+    llvm::vfs::directory_iterator dir_begin(const llvm::Twine& directory, std::error_code& error) override {
+        return m_underlyingFileSystem->dir_begin(directory, error);
+    }
+
+    std::error_code setCurrentWorkingDirectory(const llvm::Twine& path) override {
+        return m_underlyingFileSystem->setCurrentWorkingDirectory(path);
+    }
+
+    llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override {
+        return m_underlyingFileSystem->getCurrentWorkingDirectory();
+    }
+
+    std::error_code getRealPath(const llvm::Twine& path, llvm::SmallVectorImpl<char>& output) const override {
+        return m_underlyingFileSystem->getRealPath(path, output);
+    }
+
+private:
+    // Paths with dots are left to the underlying file system, ".." might leave a symbolic link
+    bool isMissing(const llvm::Twine& path) {
+        llvm::SmallString<256> absolutePath;
+        path.toVector(absolutePath);
+        if(! llvm::sys::path::is_absolute(absolutePath)) {
+            const llvm::ErrorOr<std::string> workingDirectory = getCurrentWorkingDirectory();
+            if(! workingDirectory) {
+                return false;
+            }
+            llvm::SmallString<256> relativePath(absolutePath);
+            absolutePath = *workingDirectory;
+            llvm::sys::path::append(absolutePath, relativePath);
+        }
+        const auto dot = std::find_if(llvm::sys::path::begin(absolutePath), llvm::sys::path::end(absolutePath),
+                                      [](llvm::StringRef each) { return ("." == each) || (".." == each); });
+        return (llvm::sys::path::end(absolutePath) == dot) && ! m_index.mayExist(absolutePath);
+    }
+
+    HeaderIndex& m_index;
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> m_underlyingFileSystem;
+};
+
+}
+
+HeaderIndex::HeaderIndex(const std::string& indexFile, const std::vector<std::string>& roots)
+    : m_indexFile(indexFile) {
+    for(const auto& each : roots) {
+        llvm::SmallString<256> root(each);
+        llvm::sys::fs::make_absolute(root);
+        llvm::sys::path::remove_dots(root, true);
+        while((root.size() > 1) && llvm::sys::path::is_separator(root.back())) {
+            root.pop_back();
+        }
+        m_roots.push_back(root.str());
+    }
+}
+
+void HeaderIndex::load() {
+    m_directories.clear();
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(m_indexFile);
+    llvm::StringRef data = buffer ? (*buffer)->getBuffer() : llvm::StringRef();
+    if(! data.consume_front(formatHeader)) {
+        return;
+    }
+
+    llvm::SmallVector<llvm::StringRef, 4096> lines;
+    data.split(lines, '\n', -1, false);
+    Directory* directory = nullptr;
+    for(llvm::StringRef each : lines) {
+        if(each.consume_front("D ")) {
+            llvm::StringRef modificationTime, path;
+            std::tie(modificationTime, path) = each.split(' ');
+            directory = &m_directories[path];
+            if(modificationTime.getAsInteger(10, directory->modificationTime) || path.empty()) {
+                m_directories.clear();
+                return;
+            }
+        } else if(each.consume_front("E ") && directory) {
+            directory->entries.insert(each);
+        } else {
+            m_directories.clear();
+            return;
+        }
+    }
+}
+
+bool HeaderIndex::save() const {
+    if(! m_changed) {
+        return true;
+    }
+
+    // Sorted, So unchanged trees give the same file
+    std::map<std::string, const Directory*> directories;
+    for(const auto& each : m_directories) {
+        directories[each.first()] = &each.second;
+    }
+
+    std::string content = formatHeader;
+    for(const auto& each : directories) {
+        content.append("D " + std::to_string(each.second->modificationTime) + " " + each.first + "\n");
+        std::vector<llvm::StringRef> entries;
+        for(const auto& entry : each.second->entries) {
+            entries.push_back(entry.getKey());
+        }
+        std::sort(entries.begin(), entries.end());
+        for(const auto& entry : entries) {
+            content.append("E " + entry.str() + "\n");
+        }
+    }
+    return DriverUtilities::writeFileAtomically(m_indexFile, content);
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> HeaderIndex::createFileSystem(
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem) {
+    return new HeaderIndexFileSystem(*this, std::move(underlyingFileSystem));
+}
+
+bool HeaderIndex::mayExist(llvm::StringRef absolutePath) {
+    const auto root = std::find_if(m_roots.begin(), m_roots.end(), [absolutePath](const std::string& each) {
+        return absolutePath.startswith(each) &&
+               ((absolutePath.size() == each.size()) || llvm::sys::path::is_separator(absolutePath[each.size()]));
+    });
+    if(m_roots.end() == root) {
+        return true;
+    }
+    ++m_lookups;
+
+    // Each component must be an entry of the directory before it
+    std::string directory = *root;
+    const llvm::StringRef relativePath = absolutePath.drop_front(root->size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(auto it = llvm::sys::path::begin(relativePath); it != llvm::sys::path::end(relativePath); ++it) {
+        if(llvm::sys::path::is_separator((*it)[0])) {
+            continue;
+        }
+        if(! getEntries(directory).count(*it)) {
+            ++m_rejected;
+            return false;
+        }
+        llvm::SmallString<256> child(directory);
+        llvm::sys::path::append(child, *it);
+        directory = child.str();
+    }
+    return true;
+}
+
+HeaderIndex::Statistics HeaderIndex::getStatistics() const {
+    return {m_lookups, m_rejected, m_directoriesRead};
+}
+
+const llvm::StringSet<>& HeaderIndex::getEntries(const std::string& directory) {
+    Directory& entry = m_directories[directory];
+    if(entry.validated) {
+        return entry.entries;
+    }
+    entry.validated = true;
+
+    // Files and missing directories have no entries
+    llvm::sys::fs::file_status status;
+    int64_t modificationTime = -1;
+    if(! llvm::sys::fs::status(directory, status) && llvm::sys::fs::is_directory(status)) {
+        modificationTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            status.getLastModificationTime().time_since_epoch()).count();
+    }
+    if(modificationTime == entry.modificationTime) {
+        return entry.entries;
+    }
+
+    entry.modificationTime = modificationTime;
+    entry.entries.clear();
+    std::error_code error;
+    for(llvm::sys::fs::directory_iterator it(directory, error), end; (-1 != modificationTime) && it != end && ! error;
+        it.increment(error)) {
+        entry.entries.insert(llvm::sys::path::filename(it->path()));
+    }
+    ++m_directoriesRead;
+    m_changed = true;
+    return entry.entries;
+}
@@ -0,0 +1,106 @@
+/**
+  * @file: HeaderIndex.hpp
+  * @brief: The HeaderIndex knows the entries of every directory below the given root directories. Include lookups probe
+  *         each include directory in turn, Paths the index knows to be missing are answered without asking the file system.
+  *         The index is kept in a file and a directory is read again only when its modification time changed
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Format:
+// -------
+// AutoDepMockerHeaderIndex <version>
+// D <modification time> <absolute path>  - Directory, Followed by its entries
+// E <name>                               - Entry of the directory above
+//
+// Directories are read lazily, Only the ones on the path of a lookup. A path below a root exists only when each of its
+// components is an entry of the directory before it. Every directory is checked once per process against its
+// modification time, Adding or removing an entry changes the modification time of the directory
+
+#ifndef HEADER_INDEX_HPP_
+#define HEADER_INDEX_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+class HeaderIndex {
+public:
+
+    struct Statistics {
+        unsigned lookups = 0;
+        unsigned rejected = 0; // Answered as missing without the file system
+        unsigned directoriesRead = 0;
+    };
+
+    /** Constructor
+     * @arg indexFile: File the index is kept in
+     * @arg roots: Directories whose trees are indexed(e.g. source tree, build tree and sysroot)
+     */
+    explicit HeaderIndex(const std::string& indexFile, const std::vector<std::string>& roots);
+    ~HeaderIndex() = default;
+    HeaderIndex& operator =(const HeaderIndex&) = delete;
+    HeaderIndex(const HeaderIndex&) = delete;
+
+    // Read the index file, A missing or corrupted file gives an empty index
+    void load();
+
+    // Write the index file when a directory was read, Returns false on failure
+    bool save() const;
+
+    /** Create file system
+     * @brief: Lookups of missing paths below the roots fail without reaching the underlying file system, Thread-safe
+     * @arg underlyingFileSystem: Physical file system of the worker
+     * @return: File system, Valid as long as the index is alive
+     */
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> createFileSystem(
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem);
+
+    // false when the absolute path(without dots) certainly does not exist, true when it might
+    bool mayExist(llvm::StringRef absolutePath);
+
+    Statistics getStatistics() const;
+
+private:
+    struct Directory {
+        int64_t modificationTime = 0; // Nanoseconds
+        bool validated = false; // Modification time checked by this process
+        llvm::StringSet<> entries;
+    };
+
+    // Entries of the directory, Read again when the modification time changed. Caller holds the mutex
+    const llvm::StringSet<>& getEntries(const std::string& directory);
+
+    std::string m_indexFile;
+    std::vector<std::string> m_roots;
+
+    std::mutex m_mutex;
+    llvm::StringMap<Directory> m_directories;
+    bool m_changed = false;
+
+    std::atomic<unsigned> m_lookups = {0};
+    std::atomic<unsigned> m_rejected = {0};
+    std::atomic<unsigned> m_directoriesRead = {0};
+};
+
+#endif // HEADER_INDEX_HPP_
@@ -0,0 +1,319 @@
+/**
+  * @file: MergeStage.cpp
+  * @brief: The MergeStage merges the models of a batch run while the translation units are still being parsed.
+  *         Workers hand over each model as soon as it is collected, A merge thread folds it into the merged model.
+  *         The queue between both is bounded, So workers wait when merging falls behind instead of piling up models
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <functional>
+
+#include "MergeStage.hpp"
+#include "MockModelMerger.hpp"
+
+namespace {
+
+// First element of an entry key
+enum EntryKind : uint32_t {
+    IncludeEntry,
+    ClassEntry,
+    MethodEntry,
+    CFunctionEntry,
+    EnumEntry,
+    EnumeratorEntry,
+    FieldEntry
+};
+
+std::vector<uint32_t> makeKey(const EntryKind kind, const std::string& mapKey) {
+    return {kind, StringPool::intern(mapKey)};
+}
+
+std::vector<uint32_t> appendKey(std::vector<uint32_t> key, const std::vector<uint32_t>& handles) {
+    key.insert(key.end(), handles.begin(), handles.end());
+    return key;
+}
+
+std::vector<uint32_t> appendKey(std::vector<uint32_t> key, const uint32_t handle) {
+    key.push_back(handle);
+    return key;
+}
+
+}
+
+MergeStage::MergeStage(const std::size_t capacity)
+    : m_capacity(capacity) {
+    if(0 == m_capacity) {
+        return;
+    }
+    m_pool = std::make_unique<llvm::ThreadPool>(1);
+    m_pool->async([this]() {
+        mergeQueuedModels();
+    });
+}
+
+MergeStage::~MergeStage() {
+    // Merge thread must not outlive the members it works on
+    stopMergeThread();
+}
+
+void MergeStage::push(const std::size_t position, MockModel&& model) {
+    if(! m_pool) {
+        foldModel(position, std::move(model));
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queueChanged.wait(lock, [this]() {
+            return m_queue.size() < m_capacity;
+        });
+        m_queue.emplace_back(position, std::move(model));
+    }
+    m_queueChanged.notify_all();
+}
+
+MockModel MergeStage::finish() {
+    stopMergeThread();
+
+    // Positions never pushed have no entries, The remaining ones keep their order
+    sortByRank();
+    m_entries.clear();
+    return std::move(m_model);
+}
+
+void MergeStage::stopMergeThread() {
+    if(! m_pool) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finishing = true;
+    }
+    m_queueChanged.notify_all();
+    m_pool->wait();
+}
+
+void MergeStage::mergeQueuedModels() {
+    while(true) {
+        std::pair<std::size_t, MockModel> next;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queueChanged.wait(lock, [this]() {
+                return m_finishing || ! m_queue.empty();
+            });
+            if(m_queue.empty()) {
+                return; // Finishing and everything merged
+            }
+            next = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        m_queueChanged.notify_all(); // Room for a blocked worker
+        foldModel(next.first, std::move(next.second));
+    }
+}
+
+void MergeStage::foldModel(const std::size_t position, MockModel&& model) {
+    Entry* entry = nullptr;
+
+    // Includes - Equal entries are equal, Only the rank matters
+    for(auto& each : model.includes) {
+        std::vector<InternedString>& target = m_model.includes[each.first];
+        const EntryKey mapKey = makeKey(IncludeEntry, each.first);
+        for(std::size_t i = 0; i < each.second.size(); i++) {
+            const Rank rank(position, i);
+            if(addEntry(appendKey(mapKey, each.second[i].getHandle()), rank, target.size(), entry)) {
+                target.push_back(each.second[i]);
+            } else {
+                entry->rank = std::min(entry->rank, rank);
+            }
+        }
+    }
+
+    // C++ classes - Class information of the lowest position wins
+    for(auto& each : model.classInfo) {
+        const Rank rank(position, 0);
+        if(addEntry(makeKey(ClassEntry, each.first), rank, 0, entry)) {
+            m_model.classInfo.emplace(each.first, std::move(each.second));
+        } else if(rank < entry->rank) {
+            m_model.classInfo[each.first] = std::move(each.second);
+            entry->rank = rank;
+        }
+    }
+    for(auto& each : model.classMethodInfo) {
+        foldMethods(makeKey(MethodEntry, each.first), m_model.classMethodInfo[each.first], std::move(each.second), position);
+    }
+
+    // C functions
+    for(auto& each : model.cFunctionInfo) {
+        foldMethods(makeKey(CFunctionEntry, each.first), m_model.cFunctionInfo[each.first], std::move(each.second), position);
+    }
+
+    // C and C++ enums
+    for(auto& each : model.enumInfo) {
+        foldEnums(makeKey(EnumEntry, each.first), m_model.enumInfo[each.first], std::move(each.second), position);
+    }
+
+    // Field declarations
+    for(auto& each : model.variableInfo) {
+        foldFields(makeKey(FieldEntry, each.first), m_model.variableInfo[each.first], std::move(each.second), position);
+    }
+}
+
+bool MergeStage::addEntry(EntryKey&& key, const Rank& rank, const std::size_t index, Entry*& entry) {
+    const auto inserted = m_entries.emplace(std::move(key), Entry{rank, index});
+    entry = &inserted.first->second;
+    return inserted.second;
+}
+
+void MergeStage::foldMethods(const EntryKey& mapKey, std::vector<MethodInfo>& target, std::vector<MethodInfo>&& source,
+                             const std::size_t position) {
+    Entry* entry = nullptr;
+    for(std::size_t i = 0; i < source.size(); i++) {
+        const Rank rank(position, i);
+        if(addEntry(appendKey(mapKey, MockModelMerger::getSignatureKey(source[i])), rank, target.size(), entry)) {
+            target.push_back(std::move(source[i]));
+        } else if(rank < entry->rank) {
+            target[entry->index] = std::move(source[i]);
+            entry->rank = rank;
+        }
+    }
+}
+
+void MergeStage::foldEnums(const EntryKey& mapKey, std::vector<enumProperties>& target,
+                           std::vector<enumProperties>&& source, const std::size_t position) {
+    Entry* entry = nullptr;
+    for(std::size_t i = 0; i < source.size(); i++) {
+        enumProperties& sourceEnum = source[i];
+        const EntryKey enumKey = appendKey(mapKey, sourceEnum.enumName.getHandle());
+        const Rank rank(position, i);
+        std::vector<InternedString> sourceValues = std::move(sourceEnum.enumValues);
+        sourceEnum.enumValues.clear();
+        if(addEntry(EntryKey(enumKey), rank, target.size(), entry)) {
+            target.push_back(std::move(sourceEnum));
+        } else if(rank < entry->rank) {
+            // Enumerators collected so far are kept, Only the properties of the enum are replaced
+            sourceEnum.enumValues = std::move(target[entry->index].enumValues);
+            target[entry->index] = std::move(sourceEnum);
+            entry->rank = rank;
+        }
+
+        std::vector<InternedString>& targetValues = target[entry->index].enumValues;
+        EntryKey valueKey = enumKey;
+        valueKey.front() = EnumeratorEntry;
+        Entry* valueEntry = nullptr;
+        for(std::size_t j = 0; j < sourceValues.size(); j++) {
+            const Rank valueRank(position, j);
+            if(addEntry(appendKey(valueKey, sourceValues[j].getHandle()), valueRank, targetValues.size(), valueEntry)) {
+                targetValues.push_back(sourceValues[j]);
+            } else {
+                valueEntry->rank = std::min(valueEntry->rank, valueRank);
+            }
+        }
+    }
+}
+
+void MergeStage::foldFields(const EntryKey& parentKey, std::list<VariableInfoHierarchy>& target,
+                            std::list<VariableInfoHierarchy>&& source, const std::size_t position) {
+    Entry* entry = nullptr;
+    std::size_t i = 0;
+    for(auto& sourceNode : source) {
+        const EntryKey nodeKey = appendKey(parentKey, sourceNode.variableInfo.getHandle());
+        const Rank rank(position, i++);
+        std::list<VariableInfoHierarchy>* targetChildren = nullptr;
+        if(addEntry(EntryKey(nodeKey), rank, 0, entry)) {
+            // Children are added one by one below, So each of them gets its rank
+            target.push_back({sourceNode.variableInfo, {}});
+            targetChildren = &target.back().variableInfoHierarchyList;
+        } else {
+            entry->rank = std::min(entry->rank, rank);
+            auto targetNode = std::find_if(target.begin(), target.end(), [&sourceNode](const VariableInfoHierarchy& each) {
+                return each.variableInfo == sourceNode.variableInfo;
+            });
+            targetChildren = &targetNode->variableInfoHierarchyList;
+        }
+        foldFields(nodeKey, *targetChildren, std::move(sourceNode.variableInfoHierarchyList), position);
+    }
+}
+
+const MergeStage::Rank& MergeStage::getRank(const EntryKey& key) const {
+    return m_entries.at(key).rank;
+}
+
+void MergeStage::sortByRank() {
+    // Sort a vector by the ranks of its entries, Ranks are looked up once per entry
+    const auto sortEntries = [this](auto& entries, const auto& getKey) {
+        std::vector<std::pair<Rank, std::size_t>> order;
+        order.reserve(entries.size());
+        for(std::size_t i = 0; i < entries.size(); i++) {
+            order.emplace_back(getRank(getKey(entries[i])), i);
+        }
+        std::sort(order.begin(), order.end());
+        std::remove_reference_t<decltype(entries)> sorted;
+        sorted.reserve(entries.size());
+        for(const auto& each : order) {
+            sorted.push_back(std::move(entries[each.second]));
+        }
+        entries = std::move(sorted);
+    };
+
+    for(auto& each : m_model.includes) {
+        const EntryKey mapKey = makeKey(IncludeEntry, each.first);
+        sortEntries(each.second, [&mapKey](const InternedString& include) {
+            return appendKey(mapKey, include.getHandle());
+        });
+    }
+    for(auto& each : m_model.classMethodInfo) {
+        const EntryKey mapKey = makeKey(MethodEntry, each.first);
+        sortEntries(each.second, [&mapKey](const MethodInfo& method) {
+            return appendKey(mapKey, MockModelMerger::getSignatureKey(method));
+        });
+    }
+    for(auto& each : m_model.cFunctionInfo) {
+        const EntryKey mapKey = makeKey(CFunctionEntry, each.first);
+        sortEntries(each.second, [&mapKey](const MethodInfo& function) {
+            return appendKey(mapKey, MockModelMerger::getSignatureKey(function));
+        });
+    }
+    for(auto& each : m_model.enumInfo) {
+        const EntryKey mapKey = makeKey(EnumEntry, each.first);
+        sortEntries(each.second, [&mapKey](const enumProperties& enumInfo) {
+            return appendKey(mapKey, enumInfo.enumName.getHandle());
+        });
+        for(auto& enumInfo : each.second) {
+            EntryKey valueKey = appendKey(mapKey, enumInfo.enumName.getHandle());
+            valueKey.front() = EnumeratorEntry;
+            sortEntries(enumInfo.enumValues, [&valueKey](const InternedString& value) {
+                return appendKey(valueKey, value.getHandle());
+            });
+        }
+    }
+
+    // Field hierarchies level by level, Keys extend the key of the parent node
+    const std::function<void(const EntryKey&, std::list<VariableInfoHierarchy>&)> sortFields =
+        [this, &sortFields](const EntryKey& parentKey, std::list<VariableInfoHierarchy>& nodes) {
+        nodes.sort([this, &parentKey](const VariableInfoHierarchy& lhs, const VariableInfoHierarchy& rhs) {
+            return getRank(appendKey(parentKey, lhs.variableInfo.getHandle())) <
+                   getRank(appendKey(parentKey, rhs.variableInfo.getHandle()));
+        });
+        for(auto& each : nodes) {
+            sortFields(appendKey(parentKey, each.variableInfo.getHandle()), each.variableInfoHierarchyList);
+        }
+    };
+    for(auto& each : m_model.variableInfo) {
+        sortFields(makeKey(FieldEntry, each.first), each.second);
+    }
+}
@@ -0,0 +1,124 @@
+/**
+  * @file: MergeStage.hpp
+  * @brief: The MergeStage merges the models of a batch run while the translation units are still being parsed.
+  *         Workers hand over each model as soon as it is collected, A merge thread folds it into the models next to it.
+  *         The queue between both is bounded, So workers wait when merging falls behind instead of piling up models
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Models arrive in the order their translation units finish, But the merged model must not depend on that order.
+// Every model is folded into one merged model as soon as it arrives. Each entry remembers the position of the model it
+// was first seen in and its index there, The model with the lower position wins when both have the entry.
+// finish() sorts the entries by that rank. The result is the model MockModelMerger::mergeAll() builds from the models
+// in position order, While only one merged model is kept
+
+#ifndef MERGE_STAGE_HPP_
+#define MERGE_STAGE_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/Support/ThreadPool.h"
+
+#include "MockGeneratorTypes.hpp"
+
+class MergeStage {
+public:
+
+    /** Constructor
+     * @brief: Start the merge thread
+     * @arg capacity: Models waiting to be merged before push() blocks. 0 merges within push() on the calling thread,
+     *                For processes which fork later(See ForkServer::run())
+     */
+    explicit MergeStage(const std::size_t capacity);
+    ~MergeStage();
+    MergeStage& operator =(const MergeStage&) = delete;
+    MergeStage(const MergeStage&) = delete;
+
+    // Hand over the model of the given position, Each position once. Blocks while the queue is full, Thread safe
+    void push(const std::size_t position, MockModel&& model);
+
+    // Wait until every pushed model is merged, Returns the merged model. Positions never pushed are skipped
+    MockModel finish();
+
+private:
+    // Let the merge thread empty the queue and wait until it returns
+    void stopMergeThread();
+
+    // Merge thread, Runs until finish() is called and the queue is empty
+    void mergeQueuedModels();
+
+    // Fold the model of the position into the merged model, Called by the merge thread only
+    void foldModel(const std::size_t position, MockModel&& model);
+
+    // Position of the model an entry was first seen in and its index there
+    using Rank = std::pair<std::size_t, std::size_t>;
+
+    // Kind of the entry, Map key of the model and handles identifying the entry within the map value
+    using EntryKey = std::vector<uint32_t>;
+
+    struct Entry {
+        Rank rank;
+        std::size_t index = 0; // Index in the vector of the merged model, Vectors only grow until finish()
+    };
+
+    /** Add entry
+     * @brief: Look up the entry of the key, Add it with the given rank and index when it is not there
+     * @arg entry: Entry of the key
+     * @return bool: true when the entry is new
+     */
+    bool addEntry(EntryKey&& key, const Rank& rank, const std::size_t index, Entry*& entry);
+
+    // Fold methods(C++ methods or C functions) by signature
+    void foldMethods(const EntryKey& mapKey, std::vector<MethodInfo>& target, std::vector<MethodInfo>&& source,
+                     const std::size_t position);
+
+    // Fold enums by name and their enumerators by value
+    void foldEnums(const EntryKey& mapKey, std::vector<enumProperties>& target, std::vector<enumProperties>&& source,
+                   const std::size_t position);
+
+    // Fold field hierarchies by path, parentKey identifies the parent node
+    void foldFields(const EntryKey& parentKey, std::list<VariableInfoHierarchy>& target,
+                    std::list<VariableInfoHierarchy>&& source, const std::size_t position);
+
+    // Sort the entries of the merged model by rank, Same order as merging the models in position order
+    void sortByRank();
+
+    // Rank of the entry, Which must exist
+    const Rank& getRank(const EntryKey& key) const;
+
+    std::size_t m_capacity = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_queueChanged;
+    std::deque<std::pair<std::size_t, MockModel>> m_queue;
+    bool m_finishing = false;
+
+    MockModel m_model;
+    std::map<EntryKey, Entry> m_entries;
+
+    std::unique_ptr<llvm::ThreadPool> m_pool; // Merge thread, nullptr when merging within push()
+};
+
+#endif // MERGE_STAGE_HPP_
@@ -0,0 +1,87 @@
+/**
+  * @file: PreambleCache.cpp
+  * @brief: The PreambleCache keeps the #include block(preamble) of source files precompiled on disk.
+  *         Re-runs on a source with an unchanged preamble parse only the body of the main file
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include "clang/Basic/LangOptions.h"
+#include "clang/Lex/Lexer.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "PreambleCache.hpp"
+
+PreambleCache::PreambleCache(const std::string& cacheDirectory)
+    : m_cacheDirectory(cacheDirectory) {
+    DriverUtilities::createDirectories(m_cacheDirectory);
+}
+
+std::vector<std::string> PreambleCache::prepare(const clang::tooling::CompileCommand& command) {
+    const std::string sourceFile = DriverUtilities::getAbsoluteSourcePath(command);
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(sourceFile);
+    if(! buffer) {
+        return {};
+    }
+    const llvm::StringRef content = (*buffer)->getBuffer();
+
+    // Preamble - Leading comments and preprocessor directives of the main file
+    clang::LangOptions langOptions;
+    langOptions.CPlusPlus = (".c" != llvm::sys::path::extension(sourceFile));
+    const clang::PreambleBounds bounds = clang::Lexer::ComputePreamble(content, langOptions);
+    if(0 == bounds.Size) {
+        return {};
+    }
+    const llvm::StringRef preamble = content.take_front(bounds.Size);
+
+    const std::vector<std::string> flags = DriverUtilities::getCompileFlags(command);
+    std::vector<llvm::StringRef> keyContents = {preamble, command.Directory};
+    keyContents.insert(keyContents.end(), flags.begin(), flags.end());
+    const std::string key = DriverUtilities::computeHash(keyContents);
+
+    llvm::SmallString<256> pchFile(m_cacheDirectory);
+    llvm::sys::path::append(pchFile, key + ".pch");
+
+    llvm::SmallString<256> headerFile(m_cacheDirectory);
+    llvm::sys::path::append(headerFile, key + ".h");
+    const std::string header = preamble.str() + (bounds.PreambleEndsAtStartOfLine ? "" : "\n");
+
+    // Quoted includes of the preamble are relative to the source file, not to the cache directory
+    const std::string sourceDirectory = llvm::sys::path::parent_path(sourceFile);
+    if(! m_precompiledHeaderBuilder.update(command, headerFile.str(), header, pchFile.str(), {"-iquote", sourceDirectory})) {
+        return {};
+    }
+
+    // Blank the preamble instead of removing it, Source locations of the body stay the same
+    std::string body = content.str();
+    for(std::size_t i = 0; i < bounds.Size; i++) {
+        if(('\n' != body[i]) && ('\r' != body[i])) {
+            body[i] = ' ';
+        }
+    }
+
+    // Body is derived from the current content of the source file, So concurrent runs write the same body
+    llvm::SmallString<256> bodyFile(m_cacheDirectory);
+    llvm::sys::path::append(bodyFile, DriverUtilities::computeHash({sourceFile}) + ".main");
+    if(! DriverUtilities::writeFileAtomically(bodyFile.str(), body)) {
+        return {};
+    }
+
+    std::vector<std::string> arguments = PrecompiledHeaderBuilder::getIncludeArguments(pchFile.str());
+    arguments.insert(arguments.end(), {"-Xclang", "-remap-file", "-Xclang", sourceFile + ";" + bodyFile.str().str()});
+    return arguments;
+}
@@ -0,0 +1,61 @@
+/**
+  * @file: PreambleCache.hpp
+  * @brief: The PreambleCache keeps the #include block(preamble) of source files precompiled on disk.
+  *         Re-runs on a source with an unchanged preamble parse only the body of the main file
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Cache directory layout, key is the hash of the preamble text, working directory and compile flags:
+// --------------------------------------------------------------------------------------------------
+// <key>.h        Preamble of the source file
+// <key>.pch      Precompiled preamble
+// <key>.pch.deps Files the PCH was built from(See PrecompiledHeaderBuilder.hpp)
+// <path>.main    Source file with the preamble blanked, path is the hash of the absolute source path
+
+#ifndef PREAMBLE_CACHE_HPP_
+#define PREAMBLE_CACHE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+#include "PrecompiledHeaderBuilder.hpp"
+
+class PreambleCache {
+public:
+
+    explicit PreambleCache(const std::string& cacheDirectory);
+    ~PreambleCache() = default;
+    PreambleCache& operator =(const PreambleCache&) = delete;
+    PreambleCache(const PreambleCache&) = delete;
+
+    /** Prepare
+     * @brief: Make the translation unit of the given compile command use the precompiled preamble of its source file.
+     *         PCH is built on first use and rebuilt when the preamble, the flags or any file it includes changed.
+     *         The main file is remapped to a copy with its preamble blanked, So line and column numbers are kept
+     * @arg command: Compile command of the translation unit
+     * @return std::vector<std::string>: Arguments to be added to the compile command, Empty when the source
+     *                                   has no preamble or the PCH can not be built
+     */
+    std::vector<std::string> prepare(const clang::tooling::CompileCommand& command);
+
+private:
+    std::string m_cacheDirectory;
+    PrecompiledHeaderBuilder m_precompiledHeaderBuilder;
+};
+
+#endif // PREAMBLE_CACHE_HPP_
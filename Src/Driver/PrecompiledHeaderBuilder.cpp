@@ -0,0 +1,188 @@
+/**
+  * @file: PrecompiledHeaderBuilder.cpp
+  * @brief: The PrecompiledHeaderBuilder builds a precompiled header with the flags of a translation unit and records
+  *         the files it was built from, So that callers can find out whether a PCH on disk is still usable
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <fstream>
+#include <sstream>
+
+#include "clang/Basic/SourceManager.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/FrontendActions.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "clang/Tooling/ArgumentsAdjusters.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "PrecompiledHeaderBuilder.hpp"
+#include "SingleCommandDatabase.hpp"
+
+namespace {
+
+// Input file of a PCH with the state it had when the PCH was built
+struct PCHDependency {
+    std::string path;
+    std::time_t modificationTime = 0;
+    uint64_t size = 0;
+};
+
+// GeneratePCHAction writing to a fixed output file and collecting its input files
+class PCHGeneratingAction : public clang::GeneratePCHAction {
+public:
+    PCHGeneratingAction(const std::string& pchFile, std::vector<PCHDependency>& dependencies)
+        : m_pchFile(pchFile)
+        , m_dependencies(dependencies) {
+    }
+
+protected:
+    bool BeginInvocation(clang::CompilerInstance& ci) override {
+        ci.getFrontendOpts().OutputFile = m_pchFile;
+        // Sources for foreign targets rarely compile cleanly, Declarations are usable nevertheless
+        ci.getPreprocessorOpts().AllowPCHWithCompilerErrors = true;
+        return clang::GeneratePCHAction::BeginInvocation(ci);
+    }
+
+    void EndSourceFileAction() override {
+        clang::CompilerInstance& ci = getCompilerInstance();
+        clang::SourceManager& sourceManager = ci.getSourceManager();
+        for(auto it = sourceManager.fileinfo_begin(); it != sourceManager.fileinfo_end(); ++it) {
+            const clang::FileEntry* fileEntry = it->first;
+            llvm::SmallString<256> path(fileEntry->getName());
+            ci.getFileManager().makeAbsolutePath(path);
+            m_dependencies.push_back({path.str(), fileEntry->getModificationTime(), static_cast<uint64_t>(fileEntry->getSize())});
+        }
+        clang::GeneratePCHAction::EndSourceFileAction();
+    }
+
+private:
+    std::string m_pchFile;
+    std::vector<PCHDependency>& m_dependencies;
+};
+
+class PCHGeneratingActionFactory : public clang::tooling::FrontendActionFactory {
+public:
+    PCHGeneratingActionFactory(const std::string& pchFile, std::vector<PCHDependency>& dependencies)
+        : m_pchFile(pchFile)
+        , m_dependencies(dependencies) {
+    }
+
+    clang::FrontendAction* create() override {
+        return new PCHGeneratingAction(m_pchFile, m_dependencies);
+    }
+
+private:
+    std::string m_pchFile;
+    std::vector<PCHDependency>& m_dependencies;
+};
+
+}
+
+bool PrecompiledHeaderBuilder::build(const clang::tooling::CompileCommand& command, const std::string& headerFile,
+                                     const std::string& pchFile, const std::vector<std::string>& extraArguments) {
+    SingleCommandDatabase compilations(DriverUtilities::replaceSourceFile(command, headerFile));
+
+    // Compile the header as a header of the language of the translation unit
+    std::vector<std::string> arguments = {"-x", (".c" == llvm::sys::path::extension(command.Filename)) ? "c-header" : "c++-header"};
+    arguments.insert(arguments.end(), extraArguments.begin(), extraArguments.end());
+
+    clang::tooling::ClangTool tool(compilations, {headerFile});
+    tool.appendArgumentsAdjuster(clang::tooling::getInsertArgumentAdjuster(arguments,
+                                 clang::tooling::ArgumentInsertPosition::BEGIN));
+
+    std::vector<PCHDependency> dependencies;
+    PCHGeneratingActionFactory actionFactory(pchFile, dependencies);
+    // Result is ignored on purpose, The PCH is written even when the headers have errors
+    tool.run(&actionFactory);
+
+    if(! llvm::sys::fs::exists(pchFile) || dependencies.empty()) {
+        return false;
+    }
+
+    std::ostringstream content;
+    for(const auto& each : dependencies) {
+        content << each.modificationTime << " " << each.size << " " << each.path << "\n";
+    }
+    return DriverUtilities::writeFileAtomically(getDependencyFileName(pchFile), content.str());
+}
+
+bool PrecompiledHeaderBuilder::update(const clang::tooling::CompileCommand& command, const std::string& headerFile,
+                                      const std::string& headerContent, const std::string& pchFile,
+                                      const std::vector<std::string>& extraArguments) {
+    while(! isUpToDate(pchFile)) {
+        llvm::LockFileManager lock(pchFile);
+        switch(lock) {
+        case llvm::LockFileManager::LFS_Shared:
+            // Another process builds the same PCH, Check its result once it is done
+            lock.waitForUnlock();
+            break;
+        case llvm::LockFileManager::LFS_Owned:
+        case llvm::LockFileManager::LFS_Error:
+            return isUpToDate(pchFile) ||
+                   (DriverUtilities::writeFileAtomically(headerFile, headerContent) &&
+                    build(command, headerFile, pchFile, extraArguments));
+        }
+    }
+    return true;
+}
+
+bool PrecompiledHeaderBuilder::isUpToDate(const std::string& pchFile) {
+    std::ifstream dependencyFile(getDependencyFileName(pchFile));
+    if(! dependencyFile || ! llvm::sys::fs::exists(pchFile)) {
+        return false;
+    }
+
+    PCHDependency dependency;
+    while(dependencyFile >> dependency.modificationTime >> dependency.size) {
+        dependencyFile.ignore(1); // Separator
+        std::getline(dependencyFile, dependency.path);
+
+        llvm::sys::fs::file_status status;
+        if(llvm::sys::fs::status(dependency.path, status) ||
+           (llvm::sys::toTimeT(status.getLastModificationTime()) != dependency.modificationTime) ||
+           (status.getSize() != dependency.size)) {
+            return false;
+        }
+    }
+    return dependencyFile.eof();
+}
+
+std::vector<std::string> PrecompiledHeaderBuilder::getDependencies(const std::string& pchFile) {
+    std::vector<std::string> dependencies;
+    std::ifstream dependencyFile(getDependencyFileName(pchFile));
+
+    PCHDependency dependency;
+    while(dependencyFile >> dependency.modificationTime >> dependency.size) {
+        dependencyFile.ignore(1); // Separator
+        std::getline(dependencyFile, dependency.path);
+        dependencies.push_back(dependency.path);
+    }
+    return dependencies;
+}
+
+std::vector<std::string> PrecompiledHeaderBuilder::getIncludeArguments(const std::string& pchFile) {
+    return {"-include-pch", pchFile, "-Xclang", "-fallow-pch-with-compiler-errors"};
+}
+
+std::string PrecompiledHeaderBuilder::getDependencyFileName(const std::string& pchFile) {
+    return pchFile + ".deps";
+}
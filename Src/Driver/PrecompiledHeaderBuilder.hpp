@@ -0,0 +1,74 @@
+/**
+  * @file: PrecompiledHeaderBuilder.hpp
+  * @brief: The PrecompiledHeaderBuilder builds a precompiled header with the flags of a translation unit and records
+  *         the files it was built from, So that callers can find out whether a PCH on disk is still usable
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Dependency file(<pch file>.deps) format, one line per input file of the PCH:
+// ----------------------------------------------------------------------------
+// <modification time> <size> <path>
+
+#ifndef PRECOMPILED_HEADER_BUILDER_HPP_
+#define PRECOMPILED_HEADER_BUILDER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+class PrecompiledHeaderBuilder {
+public:
+
+    // Special member functions
+    PrecompiledHeaderBuilder() = default;
+    ~PrecompiledHeaderBuilder() = default;
+    PrecompiledHeaderBuilder& operator =(const PrecompiledHeaderBuilder&) = delete;
+    PrecompiledHeaderBuilder(const PrecompiledHeaderBuilder&) = delete;
+
+    /** Build
+     * @brief: Precompile headerFile with the flags of the given compile command and write the dependency file
+     * @arg command: Compile command of a translation unit which is going to include the PCH
+     * @arg headerFile: Header to be precompiled
+     * @arg pchFile: Output file
+     * @arg extraArguments: Arguments added in front of the flags of the compile command
+     * @return bool: true when the PCH is written
+     */
+    bool build(const clang::tooling::CompileCommand& command, const std::string& headerFile, const std::string& pchFile,
+               const std::vector<std::string>& extraArguments = {});
+
+    /** Update
+     * @brief: Write headerContent to headerFile and build the PCH unless an up to date PCH exists.
+     *         Processes sharing the cache directory wait for each other, So a PCH is built only once
+     * @return bool: true when an up to date PCH exists afterwards
+     */
+    bool update(const clang::tooling::CompileCommand& command, const std::string& headerFile, const std::string& headerContent,
+                const std::string& pchFile, const std::vector<std::string>& extraArguments = {});
+
+    // false when the PCH or its dependency file is missing or any input file changed since the PCH was built
+    static bool isUpToDate(const std::string& pchFile);
+
+    // Files the given PCH was built from, Empty when the PCH has no dependency file
+    static std::vector<std::string> getDependencies(const std::string& pchFile);
+
+    // Arguments which make a translation unit include the given PCH
+    static std::vector<std::string> getIncludeArguments(const std::string& pchFile);
+
+    // Name of the dependency file of the given PCH
+    static std::string getDependencyFileName(const std::string& pchFile);
+};
+
+#endif // PRECOMPILED_HEADER_BUILDER_HPP_
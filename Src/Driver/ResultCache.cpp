@@ -0,0 +1,299 @@
+/**
+  * @file: ResultCache.cpp
+  * @brief: The ResultCache stores the mock information of translation units on disk. A translation unit whose main file,
+  *         included files and compile flags are unchanged is not parsed again, Only mock files are generated from the cache.
+  *         Several processes can share one cache directory, Oldest results are evicted when the size limit is exceeded
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+
+#include <utime.h>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "MockModelSerializer.hpp"
+#include "PrecompiledHeaderBuilder.hpp"
+#include "ResultCache.hpp"
+
+namespace {
+
+// Entry of the cache directory considered by eviction
+struct CacheFile {
+    std::string path;
+    std::time_t lastUse = 0;
+    uint64_t size = 0;
+};
+
+// Mark the file as recently used
+void touchFile(const std::string& fileName) {
+    ::utime(fileName.c_str(), nullptr);
+}
+
+}
+
+ResultCache::ResultCache(const std::string& cacheDirectory, const uint64_t maximumSize)
+    : m_cacheDirectory(cacheDirectory)
+    , m_maximumSize(maximumSize) {
+    DriverUtilities::createDirectories(m_cacheDirectory);
+}
+
+bool ResultCache::lookup(const clang::tooling::CompileCommand& command, MockModel& model, bool& success,
+                         const std::vector<std::string>* reachableFiles) {
+    const std::string manifestKey = getManifestKey(command);
+    if(manifestKey.empty()) {
+        ++m_misses;
+        return false;
+    }
+
+    // Files are known up front, No manifest of a previous parse is required
+    if(reachableFiles) {
+        const std::string resultKey = getResultKey(getReachableFilesKey(manifestKey), *reachableFiles);
+        return ! resultKey.empty() && readResult(getCacheFileName(resultKey, ".result"), model, success);
+    }
+
+    const std::string manifestFile = getCacheFileName(manifestKey, ".manifest");
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> manifest = llvm::MemoryBuffer::getFile(manifestFile);
+    if(! manifest) {
+        ++m_misses;
+        return false;
+    }
+
+    // Any included file with different content leads to a different result key
+    std::vector<std::string> keyContents = {manifestKey};
+    llvm::SmallVector<llvm::StringRef, 1024> lines;
+    (*manifest)->getBuffer().split(lines, '\n', -1, false);
+    for(const auto& each : lines) {
+        const std::pair<llvm::StringRef, llvm::StringRef> hashAndPath = each.split(' ');
+        const std::string currentHash = getFileHash(hashAndPath.second);
+        if(currentHash != hashAndPath.first) {
+            ++m_misses;
+            return false;
+        }
+        keyContents.push_back(hashAndPath.second);
+        keyContents.push_back(currentHash);
+    }
+
+    const std::string resultKey = DriverUtilities::computeHash({keyContents.begin(), keyContents.end()});
+    if(! readResult(getCacheFileName(resultKey, ".result"), model, success)) {
+        return false;
+    }
+    touchFile(manifestFile);
+    return true;
+}
+
+void ResultCache::store(const clang::tooling::CompileCommand& command, const std::vector<std::string>& extraArguments,
+                        const MockModel& model, const bool success, std::vector<std::string> includedFiles,
+                        const llvm::sys::TimePoint<>& readTime, const std::vector<std::string>* reachableFiles) {
+    const std::string manifestKey = getManifestKey(command);
+    if(manifestKey.empty() || hasNewerFile({DriverUtilities::getAbsoluteSourcePath(command)}, readTime)) {
+        return;
+    }
+
+    MockModelSerializer serializer;
+    const std::string result = (success ? "1\n" : "0\n") + serializer.serialize(model);
+
+    if(reachableFiles) {
+        const std::string resultKey = hasNewerFile(*reachableFiles, readTime) ? "" :
+                                      getResultKey(getReachableFilesKey(manifestKey), *reachableFiles);
+        if(! resultKey.empty()) {
+            DriverUtilities::writeFileAtomically(getCacheFileName(resultKey, ".result"), result);
+        }
+        return;
+    }
+
+    // Headers taken from a PCH are not known to the source manager of the translation unit.
+    // A PCH is written during the run, So only the files it was built from are checked for being too new
+    std::vector<std::string> pchFiles;
+    for(auto it = extraArguments.begin(); it != extraArguments.end(); ++it) {
+        if(("-include-pch" == *it) && (std::next(it) != extraArguments.end())) {
+            const std::vector<std::string> dependencies = PrecompiledHeaderBuilder::getDependencies(*std::next(it));
+            includedFiles.insert(includedFiles.end(), dependencies.begin(), dependencies.end());
+            pchFiles.push_back(*std::next(it));
+        }
+    }
+    if(hasNewerFile(includedFiles, readTime)) {
+        return; // Might have been parsed in its old version
+    }
+    includedFiles.insert(includedFiles.end(), pchFiles.begin(), pchFiles.end());
+    std::sort(includedFiles.begin(), includedFiles.end());
+    includedFiles.erase(std::unique(includedFiles.begin(), includedFiles.end()), includedFiles.end());
+
+    std::string manifest;
+    const std::string resultKey = getResultKey(manifestKey, includedFiles, &manifest);
+    if(resultKey.empty()) {
+        return; // Vanished or unreadable, The result would never be found again
+    }
+
+    // Result is written first, So a manifest never refers to a result which is not written yet
+    if(DriverUtilities::writeFileAtomically(getCacheFileName(resultKey, ".result"), result)) {
+        DriverUtilities::writeFileAtomically(getCacheFileName(manifestKey, ".manifest"), manifest);
+    }
+}
+
+bool ResultCache::readResult(const std::string& resultFile, MockModel& model, bool& success) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> result = llvm::MemoryBuffer::getFile(resultFile);
+    MockModelSerializer serializer;
+    MockModel cachedModel;
+    llvm::StringRef data = result ? (*result)->getBuffer() : llvm::StringRef();
+    const bool cachedSuccess = data.startswith("1\n");
+    if(! result || ! (data.consume_front("0\n") || data.consume_front("1\n")) || ! serializer.deserialize(data, cachedModel)) {
+        ++m_misses;
+        return false;
+    }
+
+    touchFile(resultFile);
+
+    model = std::move(cachedModel);
+    success = cachedSuccess;
+    ++m_hits;
+    return true;
+}
+
+std::string ResultCache::getResultKey(const std::string& manifestKey, const std::vector<std::string>& files,
+                                      std::string* manifest) {
+    std::vector<std::string> fileHashes;
+    fileHashes.reserve(files.size());
+    std::vector<llvm::StringRef> keyContents = {manifestKey};
+    for(const auto& each : files) {
+        fileHashes.push_back(getFileHash(each));
+        if(fileHashes.back().empty()) {
+            return "";
+        }
+        if(manifest) {
+            manifest->append(fileHashes.back() + " " + each + "\n");
+        }
+        keyContents.push_back(each);
+        keyContents.push_back(fileHashes.back());
+    }
+    return DriverUtilities::computeHash(keyContents);
+}
+
+bool ResultCache::hasNewerFile(const std::vector<std::string>& files, const llvm::sys::TimePoint<>& readTime) {
+    // Time stamps of the file system are coarser than the clock, So files of the last second count as newer(like ccache)
+    const llvm::sys::TimePoint<> newestAllowed = readTime - std::chrono::seconds(1);
+    for(const auto& each : files) {
+        llvm::sys::fs::file_status status;
+        if(llvm::sys::fs::status(each, status) || (status.getLastModificationTime() > newestAllowed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string ResultCache::getReachableFilesKey(const std::string& manifestKey) {
+    return DriverUtilities::computeHash({manifestKey, "reachable files"});
+}
+
+void ResultCache::evict() {
+    // Processes sharing the cache directory evict one after another, A busy lock means eviction is in progress
+    llvm::SmallString<256> lockFile(m_cacheDirectory);
+    llvm::sys::path::append(lockFile, "eviction");
+    llvm::LockFileManager lock(lockFile);
+    if(llvm::LockFileManager::LFS_Shared == lock) {
+        return;
+    }
+
+    std::vector<CacheFile> cacheFiles;
+    uint64_t totalSize = 0;
+    std::error_code error;
+    for(llvm::sys::fs::directory_iterator it(m_cacheDirectory, error), end; it != end && ! error; it.increment(error)) {
+        const llvm::StringRef extension = llvm::sys::path::extension(it->path());
+        if((".result" != extension) && (".manifest" != extension)) {
+            continue; // Temporary and lock files are in use by other processes
+        }
+
+        llvm::sys::fs::file_status status;
+        if(llvm::sys::fs::status(it->path(), status)) {
+            continue;
+        }
+        cacheFiles.push_back({it->path(), llvm::sys::toTimeT(status.getLastModificationTime()), status.getSize()});
+        totalSize += status.getSize();
+    }
+    if(totalSize <= m_maximumSize) {
+        return;
+    }
+
+    // Free a bit more than necessary, Otherwise every following run evicts again
+    const uint64_t targetSize = m_maximumSize - (m_maximumSize / 10);
+    std::sort(cacheFiles.begin(), cacheFiles.end(), [](const CacheFile& lhs, const CacheFile& rhs) {
+        return lhs.lastUse < rhs.lastUse;
+    });
+    for(const auto& each : cacheFiles) {
+        if(totalSize <= targetSize) {
+            break;
+        }
+        if(! llvm::sys::fs::remove(each.path)) {
+            totalSize -= each.size;
+        }
+    }
+}
+
+void ResultCache::setConfigurationKey(const std::string& configurationKey) {
+    m_configurationKey = configurationKey;
+}
+
+std::string ResultCache::getManifestKey(const clang::tooling::CompileCommand& command) {
+    const std::string mainFileHash = getFileHash(DriverUtilities::getAbsoluteSourcePath(command));
+    if(mainFileHash.empty()) {
+        return "";
+    }
+
+    const std::vector<std::string> flags = DriverUtilities::getCompileFlags(command);
+    std::vector<llvm::StringRef> keyContents = {mainFileHash, m_configurationKey, command.Directory};
+    keyContents.insert(keyContents.end(), flags.begin(), flags.end());
+    return DriverUtilities::computeHash(keyContents);
+}
+
+std::string ResultCache::getCacheFileName(const std::string& key, const std::string& extension) const {
+    llvm::SmallString<256> fileName(m_cacheDirectory);
+    llvm::sys::path::append(fileName, key + extension);
+    return fileName.str();
+}
+
+std::string ResultCache::getFileHash(const std::string& fileName) {
+    llvm::sys::fs::file_status status;
+    if(llvm::sys::fs::status(fileName, status)) {
+        return "";
+    }
+    const llvm::sys::TimePoint<> modificationTime = status.getLastModificationTime();
+
+    {
+        std::lock_guard<std::mutex> lock(m_fileHashMutex);
+        const auto itr = m_fileHashes.find(fileName);
+        if((m_fileHashes.end() != itr) && (itr->second.modificationTime == modificationTime) &&
+           (itr->second.size == status.getSize())) {
+            return itr->second.hash;
+        }
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> content = llvm::MemoryBuffer::getFile(fileName);
+    if(! content) {
+        return "";
+    }
+    const std::string hash = DriverUtilities::computeHash({(*content)->getBuffer()});
+
+    std::lock_guard<std::mutex> lock(m_fileHashMutex);
+    m_fileHashes[fileName] = {modificationTime, status.getSize(), hash};
+    return hash;
+}
@@ -0,0 +1,141 @@
+/**
+  * @file: ResultCache.hpp
+  * @brief: The ResultCache stores the mock information of translation units on disk. A translation unit whose main file,
+  *         included files and compile flags are unchanged is not parsed again, Only mock files are generated from the cache.
+  *         Several processes can share one cache directory, Oldest results are evicted when the size limit is exceeded
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Included files are only known after parsing, So lookup takes two steps:
+// 1. Manifest key - Hash of main file content, working directory and compile flags
+//    <manifest key>.manifest lists included files of the last parse, one "<content hash> <path>" per line
+// 2. Result key - Hash of manifest key and the current content hash of every listed file
+//    <result key>.result contains "<0|1>\n"(parse succeeded) followed by the serialized MockModel
+//
+// When the files of a translation unit are known before parsing(dependency scan), The result key is computed
+// from them directly and no manifest is written
+//
+// Content hashes are taken after parsing. A file modified after the files of the translation unit were read("too new")
+// might have been parsed in its old version, So no result is stored then.
+// Files are written to a temporary file and renamed, Readers never see partially written files.
+// Results are touched on every hit, Eviction removes the least recently used files first
+
+#ifndef RESULT_CACHE_HPP_
+#define RESULT_CACHE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+#include "llvm/Support/Chrono.h"
+
+#include "MockGeneratorTypes.hpp"
+
+class ResultCache {
+public:
+
+    // maximumSize - Size limit of the cache directory in bytes
+    explicit ResultCache(const std::string& cacheDirectory, const uint64_t maximumSize);
+    ~ResultCache() = default;
+    ResultCache& operator =(const ResultCache&) = delete;
+    ResultCache(const ResultCache&) = delete;
+
+    /** Lookup
+     * @arg command: Compile command of the translation unit
+     * @arg model: Receives the cached mock information on a hit
+     * @arg success: Receives whether the cached parse succeeded
+     * @arg reachableFiles: Files the translation unit reaches(e.g. found by DependencyScanner), When given
+     *                      the result key is computed from these files instead of the manifest of the last parse
+     * @return bool: true on a hit
+     */
+    bool lookup(const clang::tooling::CompileCommand& command, MockModel& model, bool& success,
+                const std::vector<std::string>* reachableFiles = nullptr);
+
+    /** Store
+     * @arg command: Compile command of the translation unit
+     * @arg extraArguments: Arguments added to the compile command by the driver(e.g. PCH)
+     * @arg model: Mock information collected from the translation unit
+     * @arg success: Whether the parse succeeded
+     * @arg includedFiles: Files the translation unit consists of(See ParserSettings::includedFilesSink)
+     * @arg readTime: Files of the translation unit were read at or after this time, Nothing is stored when one of
+     *                them was modified since
+     * @arg reachableFiles: Same as for lookup(), includedFiles are not used when given
+     */
+    void store(const clang::tooling::CompileCommand& command, const std::vector<std::string>& extraArguments,
+               const MockModel& model, const bool success, std::vector<std::string> includedFiles,
+               const llvm::sys::TimePoint<>& readTime, const std::vector<std::string>* reachableFiles = nullptr);
+
+    // Remove least recently used files until the cache is below its size limit
+    void evict();
+
+    // Settings which change the collected mock information(e.g. rules of the mock policy), Part of every key
+    void setConfigurationKey(const std::string& configurationKey);
+
+    unsigned getHits() const {
+        return m_hits;
+    }
+
+    unsigned getMisses() const {
+        return m_misses;
+    }
+
+private:
+    // Arguments added by the driver only make parsing faster, So they are not part of the key
+    std::string getManifestKey(const clang::tooling::CompileCommand& command);
+
+    // Read and deserialize a result file, Counts the hit or miss
+    bool readResult(const std::string& resultFile, MockModel& model, bool& success);
+
+    // Hash of the manifest key and content hashes of the files, Empty when a file can not be read.
+    // Manifest lines of the files are appended to manifest when given
+    std::string getResultKey(const std::string& manifestKey, const std::vector<std::string>& files,
+                             std::string* manifest = nullptr);
+
+    // Whether one of the files was modified after readTime or can not be checked
+    static bool hasNewerFile(const std::vector<std::string>& files, const llvm::sys::TimePoint<>& readTime);
+
+    // Results keyed by reachable files must not collide with results keyed by a manifest
+    static std::string getReachableFilesKey(const std::string& manifestKey);
+
+    std::string getCacheFileName(const std::string& key, const std::string& extension) const;
+
+    // Content hash of the file, Empty when the file can not be read.
+    // Hashes are kept per process and recomputed only when size or modification time(nanoseconds) of the file changed
+    std::string getFileHash(const std::string& fileName);
+
+    struct FileHash {
+        llvm::sys::TimePoint<> modificationTime;
+        uint64_t size = 0;
+        std::string hash;
+    };
+
+    std::string m_cacheDirectory;
+    uint64_t m_maximumSize = 0;
+    std::string m_configurationKey;
+
+    std::mutex m_fileHashMutex;
+    std::map<std::string, FileHash> m_fileHashes;
+
+    std::atomic<unsigned> m_hits = {0};
+    std::atomic<unsigned> m_misses = {0};
+};
+
+#endif // RESULT_CACHE_HPP_
@@ -0,0 +1,169 @@
+/**
+  * @file: Sharding.cpp
+  * @brief: Sharding splits the source files of a compilation database across machines. Every shard writes the mock
+  *         information of its translation units to a shard file, Merging all shard files gives the same mock files
+  *         as a single run
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "DriverUtilities.hpp"
+#include "MockFileEmitter.hpp"
+#include "MockModelMerger.hpp"
+#include "MockModelSerializer.hpp"
+#include "Sharding.hpp"
+
+namespace {
+
+const char* const formatHeader = "AutoDepMockerShard 1\n";
+
+// "<length>:<bytes>" followed by the separator
+bool readString(llvm::StringRef& data, std::string& value, const char separator) {
+    const std::size_t colon = data.find(':');
+    std::size_t length = 0;
+    if((llvm::StringRef::npos == colon) || data.substr(0, colon).getAsInteger(10, length) ||
+       (data.size() < colon + length + 2) || (separator != data[colon + 1 + length])) {
+        return false;
+    }
+    value = data.substr(colon + 1, length).str();
+    data = data.drop_front(colon + length + 2);
+    return true;
+}
+
+}
+
+bool Sharding::parseShard(llvm::StringRef specification, unsigned& index, unsigned& count) {
+    const std::pair<llvm::StringRef, llvm::StringRef> indexAndCount = specification.split('/');
+    unsigned shardIndex = 0;
+    if(indexAndCount.first.getAsInteger(10, shardIndex) || indexAndCount.second.getAsInteger(10, count) ||
+       (0 == shardIndex) || (shardIndex > count)) {
+        return false;
+    }
+    index = shardIndex - 1;
+    return true;
+}
+
+std::vector<std::string> Sharding::selectShard(const std::vector<std::string>& sourceFiles, const unsigned index,
+                                               const unsigned count) {
+    std::vector<uint64_t> sizes(sourceFiles.size(), 0);
+    for(std::size_t i = 0; i < sourceFiles.size(); i++) {
+        llvm::sys::fs::file_size(sourceFiles[i], sizes[i]); // Missing files count as empty
+    }
+
+    // Largest first, Names break ties so the order never depends on the compilation database
+    std::vector<std::size_t> order(sourceFiles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) {
+        return (sizes[lhs] != sizes[rhs]) ? (sizes[lhs] > sizes[rhs]) : (sourceFiles[lhs] < sourceFiles[rhs]);
+    });
+
+    std::vector<uint64_t> shardSizes(count, 0);
+    std::vector<bool> selected(sourceFiles.size(), false);
+    for(const std::size_t each : order) {
+        const auto smallestShard = std::min_element(shardSizes.begin(), shardSizes.end());
+        *smallestShard += sizes[each];
+        selected[each] = (index == static_cast<unsigned>(smallestShard - shardSizes.begin()));
+    }
+
+    std::vector<std::string> shard;
+    for(std::size_t i = 0; i < sourceFiles.size(); i++) {
+        if(selected[i]) {
+            shard.push_back(sourceFiles[i]);
+        }
+    }
+    return shard;
+}
+
+bool Sharding::writeShard(const std::string& shardFile, const std::vector<ShardEntry>& entries) {
+    MockModelSerializer serializer;
+    std::string content = formatHeader;
+    for(const auto& each : entries) {
+        const std::string model = serializer.serialize(each.model);
+        content.append(std::to_string(each.fileName.size()) + ":" + each.fileName + " ");
+        content.append(each.success ? "1 " : "0 ");
+        content.append(std::to_string(model.size()) + ":" + model + "\n");
+    }
+    return DriverUtilities::writeFileAtomically(shardFile, content);
+}
+
+bool Sharding::readShard(const std::string& shardFile, std::vector<ShardEntry>& entries) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(shardFile);
+    if(! buffer) {
+        return false;
+    }
+
+    llvm::StringRef data = (*buffer)->getBuffer();
+    if(! data.consume_front(formatHeader)) {
+        return false;
+    }
+
+    MockModelSerializer serializer;
+    while(! data.empty()) {
+        ShardEntry entry;
+        std::string model;
+        if(! readString(data, entry.fileName, ' ') || ! (data.startswith("0 ") || data.startswith("1 "))) {
+            return false;
+        }
+        entry.success = data.startswith("1");
+        data = data.drop_front(2);
+        if(! readString(data, model, '\n') || ! serializer.deserialize(model, entry.model)) {
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+int Sharding::mergeShards(const std::vector<std::string>& shardFiles, const unsigned jobs) {
+    std::vector<ShardEntry> entries;
+    for(const auto& each : shardFiles) {
+        if(! readShard(each, entries)) {
+            std::cerr << "Unable to read shard file " << each << std::endl;
+            return 1;
+        }
+    }
+
+    // Same order whatever the number of shards was
+    std::stable_sort(entries.begin(), entries.end(), [](const ShardEntry& lhs, const ShardEntry& rhs) {
+        return lhs.fileName < rhs.fileName;
+    });
+
+    int result = 0;
+    std::vector<MockModel> models;
+    models.reserve(entries.size());
+    for(auto& each : entries) {
+        if(! each.success) {
+            std::cerr << "Translation unit failed in its shard: " << each.fileName << std::endl;
+            result = 1;
+        }
+        models.push_back(std::move(each.model));
+    }
+
+    MockModelMerger merger;
+    const MockModel mergedModel = merger.mergeAll(std::move(models), jobs);
+    MockFileEmitter mockFileEmitter;
+    mockFileEmitter.emit(mergedModel);
+
+    std::cout << "\33[1;35mMerged " << entries.size() << " translation units of " << shardFiles.size()
+              << " shards\033[0m" << std::endl;
+    return result;
+}
@@ -0,0 +1,84 @@
+/**
+  * @file: Sharding.hpp
+  * @brief: Sharding splits the source files of a compilation database across machines. Every shard writes the mock
+  *         information of its translation units to a shard file, Merging all shard files gives the same mock files
+  *         as a single run
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Shard file format:
+// ------------------
+// AutoDepMockerShard <version>
+// One entry per translation unit: "<length>:<source file> <0|1>(succeeded) <length>:<serialized MockModel>\n"
+//
+// Shard files keep the models of the translation units apart. The merge orders them by source file, So the merge order
+// and the generated mock files do not depend on the number of shards or on which shard processed which file
+
+#ifndef SHARDING_HPP_
+#define SHARDING_HPP_
+
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/StringRef.h"
+
+#include "MockGeneratorTypes.hpp"
+
+// Mock information of one translation unit in a shard file
+struct ShardEntry {
+    std::string fileName;
+    bool success = false;
+    MockModel model;
+};
+
+class Sharding {
+public:
+
+    /** Parse shard
+     * @arg specification: "<index>/<count>", index counts from 1
+     * @arg index: Receives the index counting from 0
+     * @arg count: Receives the number of shards
+     * @return bool: false when the specification is malformed
+     */
+    static bool parseShard(llvm::StringRef specification, unsigned& index, unsigned& count);
+
+    /** Select shard
+     * @brief: Files are distributed largest first, each to the shard with the least bytes so far(ties go to the lower index).
+     *         The distribution only depends on file names and sizes, So every machine computes the same one
+     * @arg sourceFiles: All source files
+     * @arg index: Shard to be selected, Counting from 0
+     * @arg count: Number of shards
+     * @return: Source files of the shard in their original order
+     */
+    static std::vector<std::string> selectShard(const std::vector<std::string>& sourceFiles, const unsigned index,
+                                                const unsigned count);
+
+    // Write the entries to the shard file, Returns false on failure
+    static bool writeShard(const std::string& shardFile, const std::vector<ShardEntry>& entries);
+
+    // Append the entries of the shard file, Returns false when the file can not be read or is corrupted
+    static bool readShard(const std::string& shardFile, std::vector<ShardEntry>& entries);
+
+    /** Merge shards
+     * @brief: Merge the models of all shard files in order of their source files and generate mock files
+     * @arg shardFiles: Shard files of all shards
+     * @arg jobs: Number of worker threads for merging, 0 means one worker per hardware thread
+     * @return int: 0 when all translation units of all shards succeeded, 1 otherwise
+     */
+    static int mergeShards(const std::vector<std::string>& shardFiles, const unsigned jobs);
+};
+
+#endif // SHARDING_HPP_
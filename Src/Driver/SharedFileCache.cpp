@@ -0,0 +1,249 @@
+/**
+  * @file: SharedFileCache.cpp
+  * @brief: The SharedFileCache keeps file status and file contents seen by one translation unit for all following ones.
+  *         Header search of every translation unit probes the same include directories, With a shared cache each probe
+  *         reaches the file system only once per process
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <vector>
+
+#include "llvm/ADT/SmallString.h"
+
+#include "SharedFileCache.hpp"
+
+namespace {
+
+// Keeps the shared content alive as long as clang uses the buffer, Even when the cache dropped it meanwhile
+class SharedMemoryBuffer : public llvm::MemoryBuffer {
+public:
+    explicit SharedMemoryBuffer(std::shared_ptr<const llvm::MemoryBuffer> buffer, const std::string& name,
+                                const bool requiresNullTerminator)
+        : m_buffer(std::move(buffer))
+        , m_name(name) {
+        init(m_buffer->getBufferStart(), m_buffer->getBufferEnd(), requiresNullTerminator);
+    }
+
+    llvm::StringRef getBufferIdentifier() const override {
+        return m_name;
+    }
+
+    BufferKind getBufferKind() const override {
+        return m_buffer->getBufferKind();
+    }
+
+private:
+    std::shared_ptr<const llvm::MemoryBuffer> m_buffer;
+    std::string m_name;
+};
+
+class CachedFile : public llvm::vfs::File {
+public:
+    explicit CachedFile(SharedFileCache& cache, llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem,
+                        const std::string& absolutePath, const llvm::vfs::Status& status)
+        : m_cache(cache)
+        , m_underlyingFileSystem(std::move(underlyingFileSystem))
+        , m_absolutePath(absolutePath)
+        , m_status(status) {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status() override {
+        return m_status;
+    }
+
+    // Content is read on first use, Most opened files are only probed by header search
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(const llvm::Twine& name, int64_t /*fileSize*/,
+                                                                 bool requiresNullTerminator,
+                                                                 bool /*isVolatile*/) override {
+        llvm::ErrorOr<std::shared_ptr<const llvm::MemoryBuffer>> content =
+            m_cache.getContent(m_absolutePath, m_status, *m_underlyingFileSystem);
+        if(! content) {
+            return content.getError();
+        }
+        return std::unique_ptr<llvm::MemoryBuffer>(
+            new SharedMemoryBuffer(std::move(*content), name.str(), requiresNullTerminator));
+    }
+
+    std::error_code close() override {
+        return {};
+    }
+
+private:
+    SharedFileCache& m_cache;
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> m_underlyingFileSystem;
+    std::string m_absolutePath;
+    llvm::vfs::Status m_status;
+};
+
+class CachingFileSystem : public llvm::vfs::FileSystem {
+public:
+    explicit CachingFileSystem(SharedFileCache& cache, llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem)
+        : m_cache(cache)
+        , m_underlyingFileSystem(std::move(underlyingFileSystem)) {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override {
+        llvm::SmallString<256> absolutePath;
+        path.toVector(absolutePath);
+        if(makeAbsolute(absolutePath)) {
+            return m_underlyingFileSystem->status(path);
+        }
+        llvm::ErrorOr<llvm::vfs::Status> status = m_cache.getStatus(absolutePath, *m_underlyingFileSystem);
+        if(! status) {
+            return status;
+        }
+        return llvm::vfs::Status::copyWithNewName(*status, path.str());
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine& path) override {
+        llvm::SmallString<256> absolutePath;
+        path.toVector(absolutePath);
+        if(makeAbsolute(absolutePath)) {
+            return m_underlyingFileSystem->openFileForRead(path);
+        }
+        llvm::ErrorOr<llvm::vfs::Status> status = m_cache.getStatus(absolutePath, *m_underlyingFileSystem);
+        if(! status) {
+            return status.getError();
+        }
+        if(status->isDirectory()) {
+            return std::make_error_code(std::errc::is_a_directory);
+        }
+        return std::unique_ptr<llvm::vfs::File>(new CachedFile(m_cache, m_underlyingFileSystem, absolutePath.str(),
+                                                               llvm::vfs::Status::copyWithNewName(*status, path.str())));
+    }
+
+    // Directories are rarely iterated by the frontend, Not worth caching
+    llvm::vfs::directory_iterator dir_begin(const llvm::Twine& directory, std::error_code& error) override {
+        return m_underlyingFileSystem->dir_begin(directory, error);
+    }
+
+    std::error_code setCurrentWorkingDirectory(const llvm::Twine& path) override {
+        return m_underlyingFileSystem->setCurrentWorkingDirectory(path);
+    }
+
+    llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override {
+        return m_underlyingFileSystem->getCurrentWorkingDirectory();
+    }
+
+    std::error_code getRealPath(const llvm::Twine& path, llvm::SmallVectorImpl<char>& output) const override {
+        return m_underlyingFileSystem->getRealPath(path, output);
+    }
+
+private:
+    SharedFileCache& m_cache;
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> m_underlyingFileSystem;
+};
+
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> SharedFileCache::createFileSystem(
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem) {
+    return new CachingFileSystem(*this, std::move(underlyingFileSystem));
+}
+
+llvm::ErrorOr<llvm::vfs::Status> SharedFileCache::getStatus(llvm::StringRef absolutePath,
+                                                            llvm::vfs::FileSystem& underlyingFileSystem) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto itr = m_statuses.find(absolutePath);
+        if(m_statuses.end() != itr) {
+            ++m_statusHits;
+            if(itr->getValue().error) {
+                return itr->getValue().error;
+            }
+            return itr->getValue().status;
+        }
+    }
+
+    // Not locked while asking the file system, Concurrent misses of the same path store the same result
+    ++m_statusMisses;
+    llvm::ErrorOr<llvm::vfs::Status> status = underlyingFileSystem.status(absolutePath);
+    StatusEntry entry;
+    if(status) {
+        entry.status = *status;
+    } else {
+        entry.error = status.getError();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_statuses[absolutePath] = entry;
+    return status;
+}
+
+llvm::ErrorOr<std::shared_ptr<const llvm::MemoryBuffer>> SharedFileCache::getContent(
+    llvm::StringRef absolutePath, const llvm::vfs::Status& status, llvm::vfs::FileSystem& underlyingFileSystem) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto itr = m_contents.find(absolutePath);
+        if((m_contents.end() != itr) && (itr->getValue().modificationTime == status.getLastModificationTime()) &&
+           (itr->getValue().size == status.getSize())) {
+            ++m_contentHits;
+            return itr->getValue().buffer;
+        }
+    }
+
+    ++m_contentMisses;
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> file = underlyingFileSystem.openFileForRead(absolutePath);
+    if(! file) {
+        return file.getError();
+    }
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = (*file)->getBuffer(absolutePath, status.getSize(), true, false);
+    if(! buffer) {
+        return buffer.getError();
+    }
+
+    ContentEntry entry;
+    entry.modificationTime = status.getLastModificationTime();
+    entry.size = status.getSize();
+    entry.buffer = std::move(*buffer);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_contents[absolutePath] = entry;
+    return entry.buffer;
+}
+
+void SharedFileCache::revalidate(llvm::vfs::FileSystem& fileSystem) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::string> changedPaths;
+    for(const auto& each : m_statuses) {
+        const StatusEntry& entry = each.getValue();
+        llvm::ErrorOr<llvm::vfs::Status> status = fileSystem.status(each.getKey());
+        const bool unchanged = status ? (! entry.error &&
+                                         (status->getLastModificationTime() == entry.status.getLastModificationTime()) &&
+                                         (status->getSize() == entry.status.getSize()))
+                                      : (entry.error == status.getError());
+        if(! unchanged) {
+            changedPaths.push_back(each.getKey());
+        }
+    }
+
+    for(const auto& each : changedPaths) {
+        m_statuses.erase(each);
+        m_contents.erase(each);
+    }
+    m_invalidations += changedPaths.size();
+}
+
+SharedFileCache::Statistics SharedFileCache::getStatistics() const {
+    Statistics statistics;
+    statistics.statusHits = m_statusHits;
+    statistics.statusMisses = m_statusMisses;
+    statistics.contentHits = m_contentHits;
+    statistics.contentMisses = m_contentMisses;
+    statistics.invalidations = m_invalidations;
+    return statistics;
+}
@@ -0,0 +1,115 @@
+/**
+  * @file: SharedFileCache.hpp
+  * @brief: The SharedFileCache keeps file status and file contents seen by one translation unit for all following ones.
+  *         Header search of every translation unit probes the same include directories, With a shared cache each probe
+  *         reaches the file system only once per process
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// clang::FileManager is not thread-safe and resolves relative paths against its own working directory, So it can not be
+// shared by workers. The cache sits below it instead, As a file system layer every worker wraps its own file system with.
+// Failed lookups are cached as well, They are the majority with long include directory lists
+
+#ifndef SHARED_FILE_CACHE_HPP_
+#define SHARED_FILE_CACHE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+class SharedFileCache {
+public:
+
+    struct Statistics {
+        unsigned statusHits = 0;
+        unsigned statusMisses = 0;
+        unsigned contentHits = 0;
+        unsigned contentMisses = 0;
+        unsigned invalidations = 0;
+    };
+
+    explicit SharedFileCache() = default;
+    ~SharedFileCache() = default;
+    SharedFileCache& operator =(const SharedFileCache&) = delete;
+    SharedFileCache(const SharedFileCache&) = delete;
+
+    /** Create file system
+     * @brief: Lookups through the returned file system are answered from the cache, Thread-safe.
+     *         Each ClangTool needs its own file system(working directory), They all share the cache
+     * @arg underlyingFileSystem: File system of the worker, Asked on cache misses
+     * @return: File system, Valid as long as the cache is alive
+     */
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> createFileSystem(
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem);
+
+    // Drop entries of files whose existence, size or modification time changed on the given file system
+    // Must not run concurrently with parsing
+    void revalidate(llvm::vfs::FileSystem& fileSystem);
+
+    Statistics getStatistics() const;
+
+    /** Status
+     * @brief: Cached status of the absolute path
+     * @arg absolutePath: Key of the cache
+     * @arg underlyingFileSystem: Asked on a miss
+     * @return: Status or the error of the underlying file system
+     */
+    llvm::ErrorOr<llvm::vfs::Status> getStatus(llvm::StringRef absolutePath,
+                                               llvm::vfs::FileSystem& underlyingFileSystem);
+
+    /** Content
+     * @brief: Cached content of the absolute path, Read again when the status of the file changed
+     * @arg absolutePath: Key of the cache
+     * @arg status: Current status of the file
+     * @arg underlyingFileSystem: Asked on a miss
+     * @return: Content or the error of the underlying file system, Null terminated
+     */
+    llvm::ErrorOr<std::shared_ptr<const llvm::MemoryBuffer>> getContent(llvm::StringRef absolutePath,
+                                                                        const llvm::vfs::Status& status,
+                                                                        llvm::vfs::FileSystem& underlyingFileSystem);
+
+private:
+    struct StatusEntry {
+        std::error_code error;
+        llvm::vfs::Status status;
+    };
+
+    struct ContentEntry {
+        llvm::sys::TimePoint<> modificationTime;
+        uint64_t size = 0;
+        std::shared_ptr<const llvm::MemoryBuffer> buffer;
+    };
+
+    std::mutex m_mutex;
+    llvm::StringMap<StatusEntry> m_statuses;
+    llvm::StringMap<ContentEntry> m_contents;
+
+    std::atomic<unsigned> m_statusHits = {0};
+    std::atomic<unsigned> m_statusMisses = {0};
+    std::atomic<unsigned> m_contentHits = {0};
+    std::atomic<unsigned> m_contentMisses = {0};
+    std::atomic<unsigned> m_invalidations = {0};
+};
+
+#endif // SHARED_FILE_CACHE_HPP_
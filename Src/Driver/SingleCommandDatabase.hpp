@@ -0,0 +1,47 @@
+/**
+  * @file: SingleCommandDatabase.hpp
+  * @brief: Compilation database which serves exactly one compile command, Used when compile commands are
+  *         received from somewhere else than compile_commands.json or derived from another compile command
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef SINGLE_COMMAND_DATABASE_HPP_
+#define SINGLE_COMMAND_DATABASE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+class SingleCommandDatabase : public clang::tooling::CompilationDatabase {
+public:
+    explicit SingleCommandDatabase(clang::tooling::CompileCommand command)
+        : m_command(std::move(command)) {
+    }
+
+    std::vector<clang::tooling::CompileCommand> getCompileCommands(llvm::StringRef /*filePath*/) const override {
+        return {m_command};
+    }
+
+    std::vector<std::string> getAllFiles() const override {
+        return {m_command.Filename};
+    }
+
+private:
+    clang::tooling::CompileCommand m_command;
+};
+
+#endif // SINGLE_COMMAND_DATABASE_HPP_
@@ -0,0 +1,366 @@
+/**
+  * @file: SysrootImage.cpp
+  * @brief: The SysrootImage packs the header trees of a sysroot into one indexed image file. The image is memory-mapped
+  *         and serves every header lookup below the sysroot through a virtual file system, So parsing does not
+  *         depend on the latency of the storage the sysroot lives on
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <tuple>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/Errc.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "SysrootImage.hpp"
+
+namespace {
+
+const char* const formatHeader = "AutoDepMockerSysroot 1\n";
+
+// Symbolic links inside header trees are followed, The depth limit stops link loops
+const unsigned maximumDepth = 64;
+
+struct PackedImage {
+    std::string index;
+    std::string data;
+};
+
+// Walk the directory, Everything below a directory named "include" is packed
+void packDirectory(const std::string& directory, const std::string& relativePath, const bool insideTree,
+                   const unsigned depth, PackedImage& image) {
+    if(depth > maximumDepth) {
+        return;
+    }
+
+    std::error_code error;
+    for(llvm::sys::fs::directory_iterator it(directory, error), end; it != end && ! error; it.increment(error)) {
+        const std::string path = it->path();
+        const std::string name = llvm::sys::path::filename(path);
+        const std::string relative = relativePath.empty() ? name : (relativePath + "/" + name);
+
+        llvm::sys::fs::file_status status;
+        if(llvm::sys::fs::status(path, status)) {
+            continue; // Dangling symbolic link
+        }
+        const std::string modificationTime = std::to_string(llvm::sys::toTimeT(status.getLastModificationTime()));
+
+        if(llvm::sys::fs::is_directory(status)) {
+            // Symbolic links outside header trees may point anywhere(e.g. "/"), They are not followed
+            if(! insideTree && (llvm::sys::fs::file_type::directory_file != it->type())) {
+                continue;
+            }
+            const bool tree = insideTree || ("include" == name);
+            if(tree && ! insideTree) {
+                image.index.append("R " + relative + "\n");
+            }
+            if(tree) {
+                image.index.append("D " + modificationTime + " " + relative + "\n");
+            }
+            packDirectory(path, relative, tree, depth + 1, image);
+        } else if(insideTree && llvm::sys::fs::is_regular_file(status)) {
+            llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> content = llvm::MemoryBuffer::getFile(path);
+            if(! content) {
+                continue;
+            }
+            image.index.append("F " + std::to_string(image.data.size()) + " " + std::to_string((*content)->getBufferSize()) +
+                               " " + modificationTime + " " + relative + "\n");
+            image.data.append((*content)->getBuffer());
+            image.data.push_back('\0');
+        }
+    }
+}
+
+class ImageFile : public llvm::vfs::File {
+public:
+    explicit ImageFile(const llvm::vfs::Status& status, llvm::StringRef content)
+        : m_status(status)
+        , m_content(content) {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status() override {
+        return m_status;
+    }
+
+    // Content is followed by '\0' in the image, So the mapped memory is handed out as it is
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> getBuffer(const llvm::Twine& name, int64_t /*fileSize*/,
+                                                                 bool requiresNullTerminator,
+                                                                 bool /*isVolatile*/) override {
+        return llvm::MemoryBuffer::getMemBuffer(m_content, name.str(), requiresNullTerminator);
+    }
+
+    std::error_code close() override {
+        return {};
+    }
+
+private:
+    llvm::vfs::Status m_status;
+    llvm::StringRef m_content;
+};
+
+class ImageDirectoryIterator : public llvm::vfs::detail::DirIterImpl {
+public:
+    explicit ImageDirectoryIterator(std::vector<llvm::vfs::directory_entry> entries)
+        : m_entries(std::move(entries)) {
+        if(! m_entries.empty()) {
+            CurrentEntry = m_entries.front();
+        }
+    }
+
+    std::error_code increment() override {
+        ++m_index;
+        CurrentEntry = (m_index < m_entries.size()) ? m_entries[m_index] : llvm::vfs::directory_entry();
+        return {};
+    }
+
+private:
+    std::vector<llvm::vfs::directory_entry> m_entries;
+    std::size_t m_index = 0;
+};
+
+class SysrootImageFileSystem : public llvm::vfs::FileSystem {
+public:
+    explicit SysrootImageFileSystem(const SysrootImage& image,
+                                    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem)
+        : m_image(image)
+        , m_underlyingFileSystem(std::move(underlyingFileSystem)) {
+    }
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine& path) override {
+        llvm::SmallString<256> absolutePath;
+        if(! resolve(path, absolutePath)) {
+            return m_underlyingFileSystem->status(path);
+        }
+        const SysrootImage::Entry* entry = m_image.find(absolutePath);
+        if(! entry) {
+            return std::make_error_code(std::errc::no_such_file_or_directory);
+        }
+        return getStatus(path.str(), *entry);
+    }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>> openFileForRead(const llvm::Twine& path) override {
+        llvm::SmallString<256> absolutePath;
+        if(! resolve(path, absolutePath)) {
+            return m_underlyingFileSystem->openFileForRead(path);
+        }
+        const SysrootImage::Entry* entry = m_image.find(absolutePath);
+        if(! entry) {
+            return std::make_error_code(std::errc::no_such_file_or_directory);
+        }
+        if(entry->isDirectory) {
+            return std::make_error_code(std::errc::is_a_directory);
+        }
+        return std::unique_ptr<llvm::vfs::File>(new ImageFile(getStatus(path.str(), *entry), m_image.getContent(*entry)));
+    }
+
+    llvm::vfs::directory_iterator dir_begin(const llvm::Twine& directory, std::error_code& error) override {
+        llvm::SmallString<256> absolutePath;
+        if(! resolve(directory, absolutePath)) {
+            return m_underlyingFileSystem->dir_begin(directory, error);
+        }
+        const SysrootImage::Entry* entry = m_image.find(absolutePath);
+        if(! entry || ! entry->isDirectory) {
+            error = std::make_error_code(entry ? std::errc::not_a_directory : std::errc::no_such_file_or_directory);
+            return {};
+        }
+
+        // Entries are named relative to the requested directory like the physical file system does
+        const std::string directoryName = directory.str();
+        std::vector<llvm::vfs::directory_entry> entries;
+        for(const auto& each : entry->children) {
+            llvm::SmallString<256> childPath(directoryName);
+            llvm::sys::path::append(childPath, llvm::sys::path::filename(each));
+            const SysrootImage::Entry* child = m_image.find(each);
+            entries.emplace_back(childPath.str(), child->isDirectory ? llvm::sys::fs::file_type::directory_file
+                                                                     : llvm::sys::fs::file_type::regular_file);
+        }
+        error = {};
+        return llvm::vfs::directory_iterator(std::make_shared<ImageDirectoryIterator>(std::move(entries)));
+    }
+
+    std::error_code setCurrentWorkingDirectory(const llvm::Twine& path) override {
+        return m_underlyingFileSystem->setCurrentWorkingDirectory(path);
+    }
+
+    llvm::ErrorOr<std::string> getCurrentWorkingDirectory() const override {
+        return m_underlyingFileSystem->getCurrentWorkingDirectory();
+    }
+
+    std::error_code getRealPath(const llvm::Twine& path, llvm::SmallVectorImpl<char>& output) const override {
+        llvm::SmallString<256> absolutePath;
+        if(! resolve(path, absolutePath)) {
+            return m_underlyingFileSystem->getRealPath(path, output);
+        }
+        if(! m_image.find(absolutePath)) {
+            return std::make_error_code(std::errc::no_such_file_or_directory);
+        }
+        output.assign(absolutePath.begin(), absolutePath.end());
+        return {};
+    }
+
+private:
+    // Absolute path without dots, Returns true when the image serves it
+    bool resolve(const llvm::Twine& path, llvm::SmallVectorImpl<char>& absolutePath) const {
+        path.toVector(absolutePath);
+        if(! llvm::sys::path::is_absolute(absolutePath)) {
+            const llvm::ErrorOr<std::string> workingDirectory = getCurrentWorkingDirectory();
+            if(! workingDirectory) {
+                return false;
+            }
+            llvm::SmallString<256> relativePath(absolutePath.begin(), absolutePath.end());
+            absolutePath.assign(workingDirectory->begin(), workingDirectory->end());
+            llvm::sys::path::append(absolutePath, relativePath);
+        }
+        llvm::sys::path::remove_dots(absolutePath, true);
+        return m_image.isServed(llvm::StringRef(absolutePath.data(), absolutePath.size()));
+    }
+
+    static llvm::vfs::Status getStatus(const std::string& name, const SysrootImage::Entry& entry) {
+        return llvm::vfs::Status(name, entry.uniqueID, llvm::sys::toTimePoint(entry.modificationTime), 0, 0, entry.size,
+                                 entry.isDirectory ? llvm::sys::fs::file_type::directory_file
+                                                   : llvm::sys::fs::file_type::regular_file,
+                                 llvm::sys::fs::perms::all_read);
+    }
+
+    const SysrootImage& m_image;
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> m_underlyingFileSystem;
+};
+
+}
+
+bool SysrootImage::pack(const std::string& sysrootDirectory, const std::string& imageFile) {
+    llvm::SmallString<256> absoluteSysroot(sysrootDirectory);
+    if(llvm::sys::fs::make_absolute(absoluteSysroot)) {
+        return false;
+    }
+    llvm::sys::path::remove_dots(absoluteSysroot, true);
+    if(! llvm::sys::fs::is_directory(absoluteSysroot)) {
+        return false;
+    }
+
+    PackedImage image;
+    packDirectory(absoluteSysroot.str(), "", false, 0, image);
+    return DriverUtilities::writeFileAtomically(imageFile, formatHeader + absoluteSysroot.str().str() + "\n" +
+                                                image.index + "\n" + image.data);
+}
+
+bool SysrootImage::load(const std::string& imageFile) {
+    // Not volatile and no terminator required, So large images are memory-mapped instead of read
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+        llvm::MemoryBuffer::getFile(imageFile, -1, false, false);
+    if(! buffer) {
+        return false;
+    }
+
+    llvm::StringRef data = (*buffer)->getBuffer();
+    if(! data.consume_front(formatHeader)) {
+        return false;
+    }
+    const std::size_t indexEnd = data.find("\n\n");
+    if(llvm::StringRef::npos == indexEnd) {
+        return false;
+    }
+    const llvm::StringRef index = data.substr(0, indexEnd + 1);
+    m_data = data.drop_front(indexEnd + 2);
+
+    llvm::SmallVector<llvm::StringRef, 4096> lines;
+    index.split(lines, '\n', -1, false);
+    if(lines.empty()) {
+        return false;
+    }
+    m_sysrootDirectory = lines.front();
+    m_packedTrees.clear();
+    m_entries.clear();
+
+    for(std::size_t i = 1; i < lines.size(); i++) {
+        llvm::StringRef line = lines[i];
+        if(line.size() < 3) {
+            return false;
+        }
+        const char type = line.front();
+        line = line.drop_front(2);
+
+        Entry entry;
+        entry.isDirectory = ('F' != type);
+        if('F' == type) {
+            llvm::StringRef offset, size;
+            std::tie(offset, line) = line.split(' ');
+            std::tie(size, line) = line.split(' ');
+            if(offset.getAsInteger(10, entry.offset) || size.getAsInteger(10, entry.size) ||
+               (entry.offset + entry.size + 1 > m_data.size())) {
+                return false;
+            }
+        }
+        if('R' != type) {
+            llvm::StringRef modificationTime;
+            std::tie(modificationTime, line) = line.split(' ');
+            if(modificationTime.getAsInteger(10, entry.modificationTime)) {
+                return false;
+            }
+        }
+
+        llvm::SmallString<256> path(m_sysrootDirectory);
+        llvm::sys::path::append(path, line);
+        if('R' == type) {
+            m_packedTrees.push_back(path.str());
+            continue;
+        }
+        entry.uniqueID = llvm::vfs::getNextVirtualUniqueID();
+        m_entries[path] = std::move(entry);
+    }
+
+    // Child lists for directory iteration
+    for(const auto& each : m_entries) {
+        const auto parent = m_entries.find(llvm::sys::path::parent_path(each.getKey()));
+        if(m_entries.end() != parent) {
+            parent->getValue().children.push_back(each.getKey());
+        }
+    }
+    for(auto& each : m_entries) {
+        std::sort(each.getValue().children.begin(), each.getValue().children.end());
+    }
+
+    m_image = std::move(*buffer);
+    return true;
+}
+
+llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> SysrootImage::createFileSystem(
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem) const {
+    return new SysrootImageFileSystem(*this, std::move(underlyingFileSystem));
+}
+
+bool SysrootImage::isServed(llvm::StringRef absolutePath) const {
+    for(const auto& each : m_packedTrees) {
+        if(absolutePath.startswith(each) &&
+           ((absolutePath.size() == each.size()) || llvm::sys::path::is_separator(absolutePath[each.size()]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const SysrootImage::Entry* SysrootImage::find(llvm::StringRef absolutePath) const {
+    const auto itr = m_entries.find(absolutePath);
+    return (m_entries.end() != itr) ? &itr->getValue() : nullptr;
+}
+
+llvm::StringRef SysrootImage::getContent(const Entry& entry) const {
+    return m_data.substr(entry.offset, entry.size);
+}
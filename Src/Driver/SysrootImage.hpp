@@ -0,0 +1,109 @@
+/**
+  * @file: SysrootImage.hpp
+  * @brief: The SysrootImage packs the header trees of a sysroot into one indexed image file. The image is memory-mapped
+  *         and serves every header lookup below the sysroot through a virtual file system, So parsing does not
+  *         depend on the latency of the storage the sysroot lives on
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Format:
+// -------
+// AutoDepMockerSysroot <version>
+// <absolute sysroot directory>
+// R <path>                                  - Packed tree, Lookups below it are answered by the image only
+// D <modification time> <path>              - Directory
+// F <offset> <size> <modification time> <path>  - File, offset is relative to the end of the index
+// <empty line>
+// <file contents, each followed by '\0'>
+//
+// Paths are relative to the sysroot directory. Every directory named "include" is packed along with everything below it
+// Modification times are kept, So PCHs built from the image and from the sysroot validate against each other
+
+#ifndef SYSROOT_IMAGE_HPP_
+#define SYSROOT_IMAGE_HPP_
+
+#include <ctime>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/VirtualFileSystem.h"
+
+class SysrootImage {
+public:
+
+    // File or directory of the image
+    struct Entry {
+        bool isDirectory = false;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        std::time_t modificationTime = 0;
+        llvm::sys::fs::UniqueID uniqueID;
+        std::vector<std::string> children; // Absolute paths, Directories only
+    };
+
+    explicit SysrootImage() = default;
+    ~SysrootImage() = default;
+    SysrootImage& operator =(const SysrootImage&) = delete;
+    SysrootImage(const SysrootImage&) = delete;
+
+    /** Pack
+     * @arg sysrootDirectory: Sysroot whose header trees are packed
+     * @arg imageFile: Image to be written
+     * @return bool: false when the sysroot can not be read or the image can not be written
+     */
+    static bool pack(const std::string& sysrootDirectory, const std::string& imageFile);
+
+    // Map the image into memory, Returns false when the file is missing or not an image
+    bool load(const std::string& imageFile);
+
+    /** Create file system
+     * @brief: Paths below the packed trees are served from the image, Others are passed to the underlying file system.
+     *         Each ClangTool needs its own file system(working directory), They all share the mapped image
+     * @arg underlyingFileSystem: File system serving paths outside the packed trees
+     * @return: File system, Valid as long as the image is alive
+     */
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> createFileSystem(
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> underlyingFileSystem) const;
+
+    // true when the image answers lookups of the absolute path
+    bool isServed(llvm::StringRef absolutePath) const;
+
+    // Entry of the absolute path, nullptr when it is not in the image
+    const Entry* find(llvm::StringRef absolutePath) const;
+
+    // Content of a file entry, Followed by '\0'
+    llvm::StringRef getContent(const Entry& entry) const;
+
+    const std::string& getSysrootDirectory() const {
+        return m_sysrootDirectory;
+    }
+
+private:
+    std::unique_ptr<llvm::MemoryBuffer> m_image;
+    llvm::StringRef m_data;
+    std::string m_sysrootDirectory;
+    std::vector<std::string> m_packedTrees;
+    llvm::StringMap<Entry> m_entries;
+};
+
+#endif // SYSROOT_IMAGE_HPP_
@@ -0,0 +1,175 @@
+/**
+  * @file: SystemHeaderPCH.cpp
+  * @brief: The SystemHeaderPCH precompiles the system headers(#include <...>) all translation units of a recipe
+  *         start with. One PCH is built per sysroot, target and flag set and is reused by every later run
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <iostream>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "SystemHeaderPCH.hpp"
+
+namespace {
+
+// Translation units sharing working directory and compile flags
+struct TranslationUnitGroup {
+    clang::tooling::CompileCommand command;
+    std::vector<std::string> sourceFiles;
+    std::vector<std::string> sharedIncludes;
+};
+
+}
+
+SystemHeaderPCH::SystemHeaderPCH(const std::string& cacheDirectory)
+    : m_cacheDirectory(cacheDirectory) {
+    DriverUtilities::createDirectories(m_cacheDirectory);
+}
+
+ExtraArgumentsType SystemHeaderPCH::prepare(const clang::tooling::CompilationDatabase& compilations,
+                                            const std::vector<std::string>& sourceFiles) {
+    std::map<std::string, TranslationUnitGroup> groups;
+    for(const auto& each : sourceFiles) {
+        const std::vector<clang::tooling::CompileCommand> compileCommands = compilations.getCompileCommands(each);
+        if(compileCommands.empty()) {
+            continue;
+        }
+        const clang::tooling::CompileCommand& command = compileCommands.front();
+
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer =
+            llvm::MemoryBuffer::getFile(DriverUtilities::getAbsoluteSourcePath(command));
+        if(! buffer) {
+            continue;
+        }
+        const std::vector<std::string> includes = getLeadingSystemIncludes((*buffer)->getBuffer());
+
+        const std::vector<std::string> flags = DriverUtilities::getCompileFlags(command);
+        std::vector<llvm::StringRef> keyContents = {command.Directory};
+        keyContents.insert(keyContents.end(), flags.begin(), flags.end());
+        TranslationUnitGroup& group = groups[DriverUtilities::computeHash(keyContents)];
+
+        // Shared includes - Common prefix of the leading system includes of all translation units of the group
+        if(group.sourceFiles.empty()) {
+            group.command = command;
+            group.sharedIncludes = includes;
+        } else {
+            const auto mismatch = std::mismatch(group.sharedIncludes.begin(), group.sharedIncludes.end(),
+                                                includes.begin(), includes.end());
+            group.sharedIncludes.erase(mismatch.first, group.sharedIncludes.end());
+        }
+        group.sourceFiles.push_back(each);
+    }
+
+    ExtraArgumentsType extraArguments;
+    for(const auto& each : groups) {
+        const TranslationUnitGroup& group = each.second;
+        if(group.sharedIncludes.empty()) {
+            continue;
+        }
+
+        const std::string pchFile = getPCHFile(group.command, group.sharedIncludes);
+        if(pchFile.empty()) {
+            continue;
+        }
+        for(const auto& sourceFile : group.sourceFiles) {
+            extraArguments[sourceFile] = PrecompiledHeaderBuilder::getIncludeArguments(pchFile);
+        }
+    }
+    return extraArguments;
+}
+
+std::string SystemHeaderPCH::getPCHFile(const clang::tooling::CompileCommand& command,
+                                        const std::vector<std::string>& includes) {
+    const std::vector<std::string> flags = DriverUtilities::getCompileFlags(command);
+    std::vector<llvm::StringRef> keyContents = {command.Directory};
+    keyContents.insert(keyContents.end(), flags.begin(), flags.end());
+    keyContents.insert(keyContents.end(), includes.begin(), includes.end());
+    const std::string key = DriverUtilities::computeHash(keyContents);
+
+    llvm::SmallString<256> pchFile(m_cacheDirectory);
+    llvm::sys::path::append(pchFile, key + ".pch");
+    llvm::SmallString<256> headerFile(m_cacheDirectory);
+    llvm::sys::path::append(headerFile, key + ".h");
+
+    std::string header;
+    for(const auto& each : includes) {
+        header.append("#include <" + each + ">\n");
+    }
+
+    if(! PrecompiledHeaderBuilder::isUpToDate(pchFile.str())) {
+        std::cout << "\33[1;35mPrecompiling " << includes.size() << " system headers to " << pchFile.str().str() << "\033[0m" << std::endl;
+    }
+    if(! m_precompiledHeaderBuilder.update(command, headerFile.str(), header, pchFile.str())) {
+        std::cerr << "Unable to precompile system headers to " << pchFile.str().str() << std::endl;
+        return "";
+    }
+    return pchFile.str();
+}
+
+std::vector<std::string> SystemHeaderPCH::getLeadingSystemIncludes(llvm::StringRef content) {
+    std::vector<std::string> includes;
+    llvm::SmallVector<llvm::StringRef, 128> lines;
+    content.split(lines, '\n');
+
+    bool inBlockComment = false;
+    for(llvm::StringRef line : lines) {
+        line = line.trim();
+
+        // Skip comments, License headers usually come first
+        if(inBlockComment) {
+            const std::size_t commentEnd = line.find("*/");
+            if(llvm::StringRef::npos == commentEnd) {
+                continue;
+            }
+            inBlockComment = false;
+            line = line.substr(commentEnd + 2).trim();
+        }
+        while(line.startswith("/*")) {
+            const std::size_t commentEnd = line.find("*/", 2);
+            if(llvm::StringRef::npos == commentEnd) {
+                inBlockComment = true;
+                line = "";
+                break;
+            }
+            line = line.substr(commentEnd + 2).trim();
+        }
+        if(line.empty() || line.startswith("//")) {
+            continue;
+        }
+
+        // Only #include <...>, Anything else might change the meaning of the following includes
+        if(! line.consume_front("#")) {
+            break;
+        }
+        line = line.ltrim();
+        if(! line.consume_front("include")) {
+            break;
+        }
+        line = line.ltrim();
+        const std::size_t includeEnd = line.find('>');
+        if(! line.startswith("<") || (llvm::StringRef::npos == includeEnd)) {
+            break;
+        }
+        includes.push_back(line.substr(1, includeEnd - 1).str());
+    }
+    return includes;
+}
@@ -0,0 +1,75 @@
+/**
+  * @file: SystemHeaderPCH.hpp
+  * @brief: The SystemHeaderPCH precompiles the system headers(#include <...>) all translation units of a recipe
+  *         start with. One PCH is built per sysroot, target and flag set and is reused by every later run
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Translation units are grouped by their compile flags(which contain sysroot and target).
+// The PCH of a group contains the longest list of leading system includes shared by all translation units of the group.
+// Translation units still include these headers themselves, Include guards make the second inclusion a no-op
+//
+// Cache directory layout, key is the hash of working directory, compile flags and system includes:
+// -----------------------------------------------------------------------------------------------
+// <key>.h        Shared system includes
+// <key>.pch      Precompiled system includes
+// <key>.pch.deps Files the PCH was built from(See PrecompiledHeaderBuilder.hpp)
+
+#ifndef SYSTEM_HEADER_PCH_HPP_
+#define SYSTEM_HEADER_PCH_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "clang/Tooling/CompilationDatabase.h"
+
+#include "PrecompiledHeaderBuilder.hpp"
+
+// Arguments to be added to the compile command of each source file
+using ExtraArgumentsType = std::map<std::string, std::vector<std::string>>;
+
+class SystemHeaderPCH {
+public:
+
+    explicit SystemHeaderPCH(const std::string& cacheDirectory);
+    ~SystemHeaderPCH() = default;
+    SystemHeaderPCH& operator =(const SystemHeaderPCH&) = delete;
+    SystemHeaderPCH(const SystemHeaderPCH&) = delete;
+
+    /** Prepare
+     * @brief: Find the shared system includes of the given source files, build missing or outdated PCHs
+     * @arg compilations: Compilation database of the source files
+     * @arg sourceFiles: Translation units to be processed
+     * @return ExtraArgumentsType: Arguments which make each source file include its PCH, Source files without
+     *                             a usable PCH are not part of it
+     */
+    ExtraArgumentsType prepare(const clang::tooling::CompilationDatabase& compilations,
+                               const std::vector<std::string>& sourceFiles);
+
+    // Leading #include <...> directives of the source file, Stops at the first other directive or code
+    // Example: #include <vector>, #include <map>, #include "MyHeader.hpp" - Returns {vector, map}
+    static std::vector<std::string> getLeadingSystemIncludes(llvm::StringRef content);
+
+private:
+    // Build the PCH of the given includes when it is missing or outdated, Returns empty string on failure
+    std::string getPCHFile(const clang::tooling::CompileCommand& command, const std::vector<std::string>& includes);
+
+    std::string m_cacheDirectory;
+    PrecompiledHeaderBuilder m_precompiledHeaderBuilder;
+};
+
+#endif // SYSTEM_HEADER_PCH_HPP_
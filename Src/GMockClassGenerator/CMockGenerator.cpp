@@ -109,7 +109,7 @@ void CMockGenerator::constructMockFunction(const std::string& fileName, const st
         wrapper.append(PredefinedMockData::openParentheses);
         int argsSize = 0;
         for(const auto& arg : each.args) {
-            wrapper.append(arg + " ");
+            wrapper.append(arg.str() + " ");
             ++argsSize;
             wrapper.append(std::string("arg") + std::to_string(argsSize));
             if(each.args.size() != argsSize) {
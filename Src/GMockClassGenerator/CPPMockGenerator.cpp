@@ -36,7 +36,7 @@ void CPPMockGenerator::constructClass(const ClassInfo& classInfo, const std::vec
         mockClass.append(PredefinedMockData::newLine);
         for(int i=0; i<classInfo.namespaceInfo.size(); i++) {
             mockClass.append(PredefinedMockData::nameSpace); // namespace
-            mockClass.append(classInfo.namespaceInfo[i] + PredefinedMockData::aSpace); // namespace Name
+            mockClass.append(classInfo.namespaceInfo[i].str() + PredefinedMockData::aSpace); // namespace Name
             mockClass.append(PredefinedMockData::openBraces); // namespace Name{
             mockClass.append(PredefinedMockData::newLine);
         }
@@ -47,7 +47,7 @@ void CPPMockGenerator::constructClass(const ClassInfo& classInfo, const std::vec
         mockClass.append(PredefinedMockData::newLine + std::string("// Template mock class"));
         mockClass.append(PredefinedMockData::newLine + PredefinedMockData::template_ + PredefinedMockData::angleBracketOpen);
         for(int i=0; i<classInfo.templateParams.size(); i++) {
-            mockClass.append(PredefinedMockData::typename_ + classInfo.templateParams[i]);
+            mockClass.append(PredefinedMockData::typename_ + classInfo.templateParams[i].str());
             if((i + 1) == classInfo.templateParams.size()) { // End
                 mockClass.append(PredefinedMockData::angleBracketClose);
                 break;
@@ -67,7 +67,7 @@ void CPPMockGenerator::constructClass(const ClassInfo& classInfo, const std::vec
 
     // Add static method - getInstance()
     mockClass.append(PredefinedMockData::tab + PredefinedMockData::static_);
-    mockClass.append(classInfo.name + PredefinedMockData::getInstance);
+    mockClass.append(classInfo.name.str() + PredefinedMockData::getInstance);
     mockClass.append(PredefinedMockData::openParentheses + PredefinedMockData::closeParentheses);
     mockClass.append(PredefinedMockData::aSpace + PredefinedMockData::openBraces);
     mockClass.append(PredefinedMockData::newLine + PredefinedMockData::tab + PredefinedMockData::tab);
@@ -76,7 +76,7 @@ void CPPMockGenerator::constructClass(const ClassInfo& classInfo, const std::vec
     mockClass.append(PredefinedMockData::tab + PredefinedMockData::closeBraces);
     mockClass.append(PredefinedMockData::newLine + PredefinedMockData::newLine);
     mockClass.append(PredefinedMockData::tab + PredefinedMockData::static_);
-    mockClass.append(classInfo.name + PredefinedMockData::pointer);
+    mockClass.append(classInfo.name.str() + PredefinedMockData::pointer);
     mockClass.append(PredefinedMockData::thisPtr + PredefinedMockData::semicolon);
     mockClass.append(PredefinedMockData::newLine + PredefinedMockData::newLine);
 
@@ -112,8 +112,8 @@ void CPPMockGenerator::constructClass(const ClassInfo& classInfo, const std::vec
             if(calleeInfo[i].isOperatorOverloading) {
                 mockClass.append(PredefinedMockData::newLine);
                 mockClass.append(PredefinedMockData::tab);
-                mockClass.append(calleeInfo[i].returnType + PredefinedMockData::aSpace);
-                mockClass.append(calleeInfo[i].name + PredefinedMockData::openParentheses);
+                mockClass.append(calleeInfo[i].returnType.str() + PredefinedMockData::aSpace);
+                mockClass.append(calleeInfo[i].name.str() + PredefinedMockData::openParentheses);
                 auto calleeArgs = calleeInfo[i].args;
                 for(int j=0; j<calleeArgs.size(); j++) {
                     mockClass.append(calleeArgs[j]);
@@ -125,7 +125,7 @@ void CPPMockGenerator::constructClass(const ClassInfo& classInfo, const std::vec
                 mockClass.append(PredefinedMockData::closeParentheses);
                 mockClass.append(PredefinedMockData::aSpace + PredefinedMockData::openBraces + PredefinedMockData::newLine);
                 mockClass.append(PredefinedMockData::tab + PredefinedMockData::tab);
-                mockClass.append(classInfo.name + std::string("_WrapperInstance->"));
+                mockClass.append(classInfo.name.str() + std::string("_WrapperInstance->"));
                 mockClass.append(getOperatorName(calleeInfo[i].name));
                 mockClass.append(PredefinedMockData::openParentheses);
                 for(int j=0; j<calleeArgs.size(); j++) {
@@ -189,7 +189,7 @@ void CPPMockGenerator::constructWrapperClass(const ClassInfo& classInfo, const s
         mockClass.append(PredefinedMockData::newLine + std::string("// Wrapper for template mock class"));
         mockClass.append(PredefinedMockData::newLine + PredefinedMockData::template_ + PredefinedMockData::angleBracketOpen);
         for(int i=0; i<classInfo.templateParams.size(); i++) {
-            mockClass.append(PredefinedMockData::typename_ + classInfo.templateParams[i]);
+            mockClass.append(PredefinedMockData::typename_ + classInfo.templateParams[i].str());
             if((i + 1) == classInfo.templateParams.size()) { // End
                 mockClass.append(PredefinedMockData::angleBracketClose);
                 break;
@@ -200,10 +200,10 @@ void CPPMockGenerator::constructWrapperClass(const ClassInfo& classInfo, const s
 
     // Add class
     mockClass.append(PredefinedMockData::newLine);
-    mockClass.append(std::string("// Wrapper class for ") + classInfo.name + std::string(" operator overloading functions"));
+    mockClass.append(std::string("// Wrapper class for ") + classInfo.name.str() + std::string(" operator overloading functions"));
     mockClass.append(PredefinedMockData::newLine);
     mockClass.append(PredefinedMockData::class_);
-    mockClass.append(classInfo.name + std::string("_wrapper"));
+    mockClass.append(classInfo.name.str() + std::string("_wrapper"));
     mockClass.append(PredefinedMockData::aSpace);
     mockClass.append(PredefinedMockData::openBraces);
     mockClass.append(PredefinedMockData::newLine);
@@ -237,8 +237,8 @@ void CPPMockGenerator::constructWrapperClass(const ClassInfo& classInfo, const s
 
     // Add extern for accessing wrapper class from actual mock class
     mockClass.append(PredefinedMockData::newLine);
-    mockClass.append(classInfo.name + std::string("_wrapper* "));
-    mockClass.append(classInfo.name + std::string("_WrapperInstance") + PredefinedMockData::initialization);
+    mockClass.append(classInfo.name.str() + std::string("_wrapper* "));
+    mockClass.append(classInfo.name.str() + std::string("_WrapperInstance") + PredefinedMockData::initialization);
     mockClass.append(PredefinedMockData::newLine);
 }
 
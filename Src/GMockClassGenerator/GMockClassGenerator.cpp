@@ -20,7 +20,7 @@
 
 #include "GMockClassGenerator.hpp"
 
-void GMockClassGenerator::constructIncludes(const std::string& fileName, const std::vector<std::string>& includes) {
+void GMockClassGenerator::constructIncludes(const std::string& fileName, const std::vector<InternedString>& includes) {
     // constructIncludes() can be called from any generator as it is implemented in GeneratorUtilities
     m_cppMockgenerator.constructIncludes(fileName, includes);
 }
@@ -36,7 +36,7 @@ public:
     GMockClassGenerator(const GMockClassGenerator&) = delete;
 
     // IMockGenerator interface
-    void constructIncludes(const std::string& fileName, const std::vector<std::string>& includes) override;
+    void constructIncludes(const std::string& fileName, const std::vector<InternedString>& includes) override;
     void constructEnum(const std::string& fileName, const std::vector<enumProperties>& enumProp) override;
     void constructClass(const ClassInfo& classInfo, const std::vector<MethodInfo>& calleeInfo) override;
     void constructCFunction(const std::string& fileName, const std::vector<MethodInfo>& methodsInfo) override;
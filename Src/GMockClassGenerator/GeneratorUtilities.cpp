@@ -25,7 +25,7 @@
 // Generate Include information
 // Example: /usr/include/MyIncludes/include.hpp
 //          Finally extract MyInclude/include.hpp - path without std include location
-void GeneratorUtilities::constructIncludes(const std::string& fileName, const std::vector<std::string>& includes) {
+void GeneratorUtilities::constructIncludes(const std::string& fileName, const std::vector<InternedString>& includes) {
     // Add fileInfo which includes copyright information
     mockFile.append(PredefinedMockData::fileInfo);
 
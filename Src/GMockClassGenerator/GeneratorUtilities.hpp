@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "Defines.hpp"
+#include "StringPool.hpp"
 
 // Basic utilities for generating mock class
 class GeneratorUtilities {
@@ -42,7 +43,7 @@ public:
     // Example: Given: {/usr/include/MyIncludes/include1.hpp, /usr/include/MyIncludes/include2.hpp}
     //          Written: MyInclude/include1.hpp
     //                   MyInclude/include2.hpp
-    void constructIncludes(const std::string& fileName, const std::vector<std::string>& includes);
+    void constructIncludes(const std::string& fileName, const std::vector<InternedString>& includes);
 
     // Open files generated in ./GeneratedMocks directory
     // Append #endif at last line of the file
@@ -21,27 +21,452 @@
  */
 
 
+#include <algorithm>
+#include <iterator>
+
 #include "clang/AST/ASTContext.h"
+#include "clang/Tooling/ArgumentsAdjusters.h"
 #include "clang/Tooling/CommonOptionsParser.h"
 #include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/StringSaver.h"
 
+#include "ASTFileImporter.hpp"
 #include "CustomFrontendAction.hpp"
+#include "BatchRunner.hpp"
+#include "CompactDiagnosticConsumer.hpp"
+#include "CostHistory.hpp"
+#include "DaemonServer.hpp"
+#include "DependencyScanner.hpp"
+#include "ExpandedCompilationDatabase.hpp"
+#include "HeaderIndex.hpp"
+#include "Logger.hpp"
+#include "MockPolicy.hpp"
+#include "PreambleCache.hpp"
+#include "ResultCache.hpp"
+#include "Sharding.hpp"
+#include "SysrootImage.hpp"
+#include "SystemHeaderPCH.hpp"
 
 // Helpers
 llvm::cl::OptionCategory FindDeclCategory("main options");
-static char FindDeclUsage[] = "AutoDepMocker <source file> --";
+static char FindDeclUsage[] = "AutoDepMocker <source file> --\n"
+                              "       AutoDepMocker --batch --compile-commands-dir=<build directory> [--batch-filter=<glob>] [-j <jobs>]\n"
+                              "       AutoDepMocker --batch --shard=<i>/<n> --shard-file=<file> [batch options]\n"
+                              "       AutoDepMocker --merge-shards <shard file>... --\n"
+                              "       AutoDepMocker --daemon=<socket>\n"
+                              "       AutoDepMocker --connect=<socket> <source file> --\n"
+                              "       AutoDepMocker --pack-sysroot=<sysroot> --sysroot-image=<image>";
+
+// Batch mode options
+static llvm::cl::opt<bool> BatchMode("batch",
+    llvm::cl::desc("Generate mocks for every source file of the compilation database"),
+    llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> BatchFilter("batch-filter",
+    llvm::cl::desc("Process only the compilation database entries matching the glob pattern"),
+    llvm::cl::value_desc("glob"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> CompileCommandsDir("compile-commands-dir",
+    llvm::cl::desc("Directory containing compile_commands.json, Used by batch mode when no source file is given"),
+    llvm::cl::value_desc("directory"), llvm::cl::init("."), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<unsigned> Jobs("j",
+    llvm::cl::desc("Number of worker threads in batch mode(default: number of hardware threads)"),
+    llvm::cl::init(0), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<bool> ForkWorkers("fork-workers",
+    llvm::cl::desc("Run each translation unit of a batch in a process forked from the driver instead of a thread, "
+                   "Workers inherit everything the driver loaded"),
+    llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> CostHistoryFile("cost-history",
+    llvm::cl::desc("File recording wall time and memory of each translation unit, Batch mode starts the most "
+                   "expensive ones first(default: none, Costs are not recorded)"),
+    llvm::cl::value_desc("file"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<unsigned> MemoryBudget("memory-budget",
+    llvm::cl::desc("Memory in MiB translation units running concurrently in batch mode may use together as recorded "
+                   "in the cost history(default: 0, unlimited)"),
+    llvm::cl::init(0), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<unsigned> TranslationUnitTimeLimit("tu-time-limit",
+    llvm::cl::desc("Seconds a translation unit may be parsed, Parsing stops after the current top-level declaration and "
+                   "the mocks collected so far are generated. Limits are checked only between top-level declarations, "
+                   "So without --fork-workers a single huge namespace or class can not be stopped(default: 0, unlimited)"),
+    llvm::cl::init(0), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<unsigned> TranslationUnitMemoryLimit("tu-memory-limit",
+    llvm::cl::desc("Memory in MiB the AST of a translation unit may use, Parsing stops after the current top-level "
+                   "declaration and the mocks collected so far are generated. Approximate, The AST is measured every 64 "
+                   "top-level declarations. With --fork-workers the address space a worker may add is limited to the "
+                   "same size by the kernel(default: 0, unlimited)"),
+    llvm::cl::init(0), llvm::cl::cat(FindDeclCategory));
+
+// Sharding options
+static llvm::cl::opt<std::string> Shard("shard",
+    llvm::cl::desc("Process only shard <i> of <n> of the batch source files, Shards are balanced by file size"),
+    llvm::cl::value_desc("i/n"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> ShardFile("shard-file",
+    llvm::cl::desc("File receiving the mock information of the shard, Mock files are generated by --merge-shards"),
+    llvm::cl::value_desc("file"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<bool> MergeShards("merge-shards",
+    llvm::cl::desc("Merge the given shard files and generate mock files"),
+    llvm::cl::cat(FindDeclCategory));
+
+// Daemon mode options
+static llvm::cl::opt<std::string> DaemonSocket("daemon",
+    llvm::cl::desc("Keep running and serve mock generation requests on the given Unix domain socket"),
+    llvm::cl::value_desc("socket"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> ConnectSocket("connect",
+    llvm::cl::desc("Send the compile command of the source file to a daemon listening on the given socket"),
+    llvm::cl::value_desc("socket"), llvm::cl::cat(FindDeclCategory));
+
+// Preamble cache options
+static llvm::cl::opt<std::string> PreambleCacheDir("preamble-cache",
+    llvm::cl::desc("Keep the #include block of source files precompiled in the given directory, "
+                   "Re-runs with an unchanged #include block parse only the body of the source file"),
+    llvm::cl::value_desc("directory"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> SysrootPCHDir("sysroot-pch",
+    llvm::cl::desc("Precompile the system headers shared by the source files once per sysroot, target and "
+                   "compilation options and keep them in the given directory"),
+    llvm::cl::value_desc("directory"), llvm::cl::cat(FindDeclCategory));
+
+// Result cache options
+static llvm::cl::opt<std::string> ResultCacheDir("result-cache",
+    llvm::cl::desc("Keep mock information of translation units in the given directory, Unchanged translation units "
+                   "are not parsed again. Mock information of all source files is merged like in batch mode"),
+    llvm::cl::value_desc("directory"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<unsigned> ResultCacheSize("result-cache-size",
+    llvm::cl::desc("Size limit of the result cache in MiB, Least recently used results are evicted(default: 1024)"),
+    llvm::cl::init(1024), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<bool> ScanDependencies("scan-dependencies",
+    llvm::cl::desc("Find the headers of each source file with a preprocessor-only dependency scan before parsing, "
+                   "Source files whose headers are unchanged are taken from the result cache without a parse"),
+    llvm::cl::cat(FindDeclCategory));
+
+// Sysroot image options
+static llvm::cl::opt<std::string> PackSysroot("pack-sysroot",
+    llvm::cl::desc("Pack the header trees of the given sysroot into the image given by --sysroot-image and exit"),
+    llvm::cl::value_desc("sysroot"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> SysrootImageFile("sysroot-image",
+    llvm::cl::desc("Serve headers of the packed sysroot from the given image instead of the file system"),
+    llvm::cl::value_desc("image"), llvm::cl::cat(FindDeclCategory));
+
+// Header index options
+static llvm::cl::opt<std::string> HeaderIndexFile("header-index",
+    llvm::cl::desc("Keep the directory entries below --header-index-root in the given file, "
+                   "Lookups of headers missing there are answered without the file system"),
+    llvm::cl::value_desc("file"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::list<std::string> HeaderIndexRoots("header-index-root",
+    llvm::cl::desc("Directory indexed by --header-index(e.g. source tree, build tree or sysroot), Can be repeated"),
+    llvm::cl::value_desc("directory"), llvm::cl::cat(FindDeclCategory));
+
+// Parser options
+static llvm::cl::opt<bool> SkipHeaderFunctionBodies("skip-header-function-bodies",
+    llvm::cl::desc("Skip parsing function bodies outside the given source file(default: true)"),
+    llvm::cl::init(true), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<bool> CompactDiagnostics("compact-diagnostics",
+    llvm::cl::desc("Count diagnostics by category and print only the first messages of each file without source "
+                   "snippets(default: true)"),
+    llvm::cl::init(true), llvm::cl::cat(FindDeclCategory));
+
+// Mock policy options
+static llvm::cl::opt<std::string> MockPolicyFile("mock-policy",
+    llvm::cl::desc("Decide which files and symbols are mocked by the allow and deny rules of the given file "
+                   "instead of asking"),
+    llvm::cl::value_desc("file"), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<bool> RecordMockPolicy("record-mock-policy",
+    llvm::cl::desc("Ask for files the --mock-policy has no rule for and append the answers to it, "
+                   "So the next run replays them without asking"),
+    llvm::cl::cat(FindDeclCategory));
+
+// Log options
+static llvm::cl::opt<LogLevel> LogLevelOption("log-level",
+    llvm::cl::desc("Write records of the given level and above to the log file(default: warn)"),
+    llvm::cl::values(clEnumValN(LogLevel::Debug, "debug", "Every visited declaration and expression"),
+                     clEnumValN(LogLevel::Info, "info", "Decisions about files and symbols"),
+                     clEnumValN(LogLevel::Warn, "warn", "Declarations which could not be processed"),
+                     clEnumValN(LogLevel::Error, "error", "Errors only"),
+                     clEnumValN(LogLevel::Off, "off", "No log file")),
+    llvm::cl::init(LogLevel::Warn), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<LogFormat> LogFormatOption("log-format",
+    llvm::cl::desc("Format of the log file(default: text)"),
+    llvm::cl::values(clEnumValN(LogFormat::Text, "text", "One \"<LEVEL>: <message>\" line per record"),
+                     clEnumValN(LogFormat::JsonLines, "jsonl", "One JSON object per line with time, process and thread"),
+                     clEnumValN(LogFormat::Binary, "binary", "Length prefixed binary records")),
+    llvm::cl::init(LogFormat::Text), llvm::cl::cat(FindDeclCategory));
+static llvm::cl::opt<std::string> LogFile("log-file",
+    llvm::cl::desc("Log file(default: AutoDepMocker.log)"),
+    llvm::cl::value_desc("file"), llvm::cl::init("AutoDepMocker.log"), llvm::cl::cat(FindDeclCategory));
+
+// Arguments which make the given source files use precompiled headers
+// Only one PCH can be included, The preamble already contains the system headers
+static ExtraArgumentsType getPrecompiledHeaderArguments(const clang::tooling::CompilationDatabase& compilations,
+                                                        const std::vector<std::string>& sourceFiles) {
+    // Serialized ASTs are not parsed
+    std::vector<std::string> parsedFiles;
+    std::copy_if(sourceFiles.begin(), sourceFiles.end(), std::back_inserter(parsedFiles),
+                 [](const std::string& each) { return ! ASTFileImporter::isASTFile(each); });
+
+    ExtraArgumentsType extraArguments;
+    if(! PreambleCacheDir.empty()) {
+        PreambleCache preambleCache(PreambleCacheDir);
+        for(const auto& each : parsedFiles) {
+            const auto compileCommands = compilations.getCompileCommands(each);
+            if(! compileCommands.empty()) {
+                std::vector<std::string> arguments = preambleCache.prepare(compileCommands.front());
+                if(! arguments.empty()) {
+                    extraArguments[each] = std::move(arguments);
+                }
+            }
+        }
+    } else if(! SysrootPCHDir.empty()) {
+        SystemHeaderPCH systemHeaderPCH(SysrootPCHDir);
+        extraArguments = systemHeaderPCH.prepare(compilations, parsedFiles);
+    }
+    return extraArguments;
+}
+
+// Same as getPrecompiledHeaderArguments() for a batch runner. Preambles are prepared by its workers instead of
+// one after another before the run
+static void setPrecompiledHeaders(BatchRunner& batchRunner, std::unique_ptr<PreambleCache>& preambleCache,
+                                  const clang::tooling::CompilationDatabase& compilations,
+                                  const std::vector<std::string>& sourceFiles) {
+    if(! PreambleCacheDir.empty()) {
+        preambleCache = std::make_unique<PreambleCache>(PreambleCacheDir);
+        batchRunner.setPreambleCache(preambleCache.get());
+    } else {
+        batchRunner.setExtraArguments(getPrecompiledHeaderArguments(compilations, sourceFiles));
+    }
+}
 
 int main(int argc, const char **argv) {
 
+    // Flag sets of large projects exceed the command line limit, So arguments can be given in @response files.
+    // Expanded before the compilation options after "--" are split off
+    llvm::BumpPtrAllocator argumentAllocator;
+    llvm::StringSaver argumentSaver(argumentAllocator);
+    llvm::SmallVector<const char*, 256> arguments(argv, argv + argc);
+    llvm::cl::ExpandResponseFiles(argumentSaver, llvm::cl::TokenizeGNUCommandLine, arguments);
+    int argumentCount = static_cast<int>(arguments.size());
+
     // locates and loads a compilation command database
-    clang::tooling::CommonOptionsParser optionParser(argc, argv, FindDeclCategory,
-                                                     FindDeclUsage);
+    // Source file is optional in batch mode, Files are taken from the compilation database then
+    clang::tooling::CommonOptionsParser optionParser(argumentCount, arguments.data(), FindDeclCategory,
+                                                     llvm::cl::ZeroOrMore, FindDeclUsage);
+
+    // Before any worker thread or child process exists, So all of them append to the same file.
+    // Every run starts a new log, Except clients of a daemon which might be writing to the same file
+    Logger::configure(LogFile, LogLevelOption, LogFormatOption, ConnectSocket.empty());
+
+    ParserSettings settings;
+    settings.skipFunctionBodiesOutsideMainFile = SkipHeaderFunctionBodies;
+    settings.compactDiagnostics = CompactDiagnostics;
+
+    // Compiled once, Shared by all translation units
+    MockPolicy mockPolicy;
+    if(! MockPolicyFile.empty()) {
+        std::string errorMessage;
+        if(! mockPolicy.load(MockPolicyFile, RecordMockPolicy, errorMessage)) {
+            llvm::errs() << errorMessage << "\n";
+            return 1;
+        }
+        settings.mockPolicy = &mockPolicy;
+    } else if(RecordMockPolicy) {
+        llvm::errs() << "--record-mock-policy requires --mock-policy\n";
+        return 1;
+    }
+
+    if(! PackSysroot.empty()) {
+        if(SysrootImageFile.empty()) {
+            llvm::errs() << "--pack-sysroot requires --sysroot-image\n";
+            return 1;
+        }
+        if(! SysrootImage::pack(PackSysroot, SysrootImageFile)) {
+            llvm::errs() << "Unable to pack " << PackSysroot << " to " << SysrootImageFile << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Mapped once, Shared by all ClangTools of the process
+    std::unique_ptr<SysrootImage> sysrootImage;
+    if(! SysrootImageFile.empty()) {
+        sysrootImage = std::make_unique<SysrootImage>();
+        if(! sysrootImage->load(SysrootImageFile)) {
+            llvm::errs() << "Unable to load sysroot image " << SysrootImageFile << "\n";
+            return 1;
+        }
+    }
+
+    // Read once per process, The daemon is not given the index since directories are validated only once
+    std::unique_ptr<HeaderIndex> headerIndex;
+    if(! HeaderIndexFile.empty()) {
+        if(HeaderIndexRoots.empty()) {
+            llvm::errs() << "--header-index requires --header-index-root\n";
+            return 1;
+        }
+        headerIndex = std::make_unique<HeaderIndex>(HeaderIndexFile, HeaderIndexRoots);
+        headerIndex->load();
+    }
+
+    // Every run which parsed translation units ends here, So recorded answers and lookups are never lost
+    const auto finishRun = [&headerIndex, &mockPolicy]() {
+        if(headerIndex && ! headerIndex->save()) {
+            llvm::errs() << "Unable to write header index " << HeaderIndexFile << "\n";
+        }
+        if(! mockPolicy.save()) {
+            llvm::errs() << "Unable to write mock policy " << MockPolicyFile << "\n";
+        }
+        if(Logger::getDroppedCount()) {
+            llvm::errs() << Logger::getDroppedCount() << " log records dropped, The log file could not keep up\n";
+        }
+    };
+
+    if(! DaemonSocket.empty()) {
+        DaemonServer daemonServer(DaemonSocket, settings, PreambleCacheDir, sysrootImage.get());
+        const int result = daemonServer.run();
+        finishRun();
+        return result;
+    }
+
+    if(! ConnectSocket.empty()) {
+        const auto sourceFiles = optionParser.getSourcePathList();
+        if(1 != sourceFiles.size()) {
+            llvm::errs() << "Exactly one source file is expected with --connect\n";
+            return 1;
+        }
+        const ExpandedCompilationDatabase compilations(optionParser.getCompilations());
+        const auto compileCommands = compilations.getCompileCommands(sourceFiles.front());
+        if(compileCommands.empty()) {
+            llvm::errs() << "No compile command found for " << sourceFiles.front() << "\n";
+            return 1;
+        }
+        return DaemonServer::sendRequest(ConnectSocket, compileCommands.front());
+    }
+
+    if(MergeShards) {
+        return Sharding::mergeShards(optionParser.getSourcePathList(), Jobs);
+    }
+
+    if(BatchMode) {
+        // Explicitly given source files take precedence over the compilation database entries
+        // CommonOptionsParser loads the compilation database only when source files are given
+        std::unique_ptr<clang::tooling::CompilationDatabase> batchCompilations;
+        const clang::tooling::CompilationDatabase* compilations = nullptr;
+        std::vector<std::string> sourceFiles = optionParser.getSourcePathList();
+        if(sourceFiles.empty()) {
+            std::string errorMessage;
+            batchCompilations = clang::tooling::CompilationDatabase::autoDetectFromDirectory(CompileCommandsDir, errorMessage);
+            if(! batchCompilations) {
+                llvm::errs() << errorMessage << "\n";
+                return 1;
+            }
+            compilations = batchCompilations.get();
+            sourceFiles = BatchRunner::selectSourceFiles(*compilations, BatchFilter);
+        } else {
+            compilations = &optionParser.getCompilations();
+        }
+        if(sourceFiles.empty()) {
+            llvm::errs() << "No source files found for batch mode\n";
+            return 1;
+        }
+
+        // Translation units with the same flags share one argument list
+        const ExpandedCompilationDatabase expandedCompilations(*compilations);
+        compilations = &expandedCompilations;
+
+        if(! Shard.empty()) {
+            unsigned shardIndex = 0;
+            unsigned shardCount = 0;
+            if(! Sharding::parseShard(Shard, shardIndex, shardCount) || ShardFile.empty()) {
+                llvm::errs() << "--shard=<i>/<n> with 1 <= i <= n and --shard-file are required for sharding\n";
+                return 1;
+            }
+            sourceFiles = Sharding::selectShard(sourceFiles, shardIndex, shardCount);
+
+            // More shards than source files, Merge still expects a shard file
+            if(sourceFiles.empty()) {
+                return Sharding::writeShard(ShardFile, {}) ? 0 : 1;
+            }
+        }
+
+        std::unique_ptr<ResultCache> resultCache;
+        std::unique_ptr<PreambleCache> preambleCache;
+        DependencyScanner dependencyScanner;
+        CostHistory costHistory(CostHistoryFile);
+        BatchRunner batchRunner(*compilations, settings, Jobs);
+        if(! CostHistoryFile.empty()) {
+            costHistory.load();
+            batchRunner.setCostHistory(&costHistory);
+        }
+        batchRunner.setMemoryBudget(uint64_t(MemoryBudget) * 1024 * 1024);
+        batchRunner.setForkWorkers(ForkWorkers);
+        batchRunner.setLimits(std::chrono::seconds(TranslationUnitTimeLimit),
+                              std::size_t(TranslationUnitMemoryLimit) * 1024 * 1024);
+        setPrecompiledHeaders(batchRunner, preambleCache, *compilations, sourceFiles);
+        batchRunner.setSysrootImage(sysrootImage.get());
+        batchRunner.setHeaderIndex(headerIndex.get());
+        batchRunner.setShardFile(ShardFile);
+        if(! ResultCacheDir.empty()) {
+            resultCache = std::make_unique<ResultCache>(ResultCacheDir, uint64_t(ResultCacheSize) * 1024 * 1024);
+            resultCache->setConfigurationKey(mockPolicy.getRules());
+            batchRunner.setResultCache(resultCache.get());
+            if(ScanDependencies) {
+                batchRunner.setDependencyScanner(&dependencyScanner);
+            }
+        }
+        const int result = batchRunner.run(sourceFiles);
+        batchRunner.printSummary();
+        finishRun();
+        return result;
+    }
 
     // Expect to get only one source file for mock generation
     const auto sourceFiles = optionParser.getSourcePathList();
+    if(sourceFiles.empty()) {
+        llvm::errs() << "No source file given\n";
+        return 1;
+    }
+    const ExpandedCompilationDatabase compilations(optionParser.getCompilations());
+
+    // Serialized ASTs of the build are loaded, Nothing to precompile or cache
+    if(std::any_of(sourceFiles.begin(), sourceFiles.end(), ASTFileImporter::isASTFile)) {
+        BatchRunner batchRunner(compilations, settings, Jobs);
+        batchRunner.setHeaderIndex(headerIndex.get());
+        const int result = batchRunner.run(sourceFiles);
+        batchRunner.printSummary();
+        finishRun();
+        return result;
+    }
+
+    if(! ResultCacheDir.empty()) {
+        ResultCache resultCache(ResultCacheDir, uint64_t(ResultCacheSize) * 1024 * 1024);
+        resultCache.setConfigurationKey(mockPolicy.getRules());
+        std::unique_ptr<PreambleCache> preambleCache;
+        DependencyScanner dependencyScanner;
+        BatchRunner batchRunner(compilations, settings, Jobs);
+        setPrecompiledHeaders(batchRunner, preambleCache, compilations, sourceFiles);
+        batchRunner.setSysrootImage(sysrootImage.get());
+        batchRunner.setHeaderIndex(headerIndex.get());
+        batchRunner.setResultCache(&resultCache);
+        if(ScanDependencies) {
+            batchRunner.setDependencyScanner(&dependencyScanner);
+        }
+        const int result = batchRunner.run(sourceFiles);
+        batchRunner.printSummary();
+        finishRun();
+        return result;
+    }
+
+    // Unchanged #include blocks are taken precompiled from the cache
+    const ExtraArgumentsType extraArguments = getPrecompiledHeaderArguments(compilations, sourceFiles);
 
     // ClangTool - Utility to run a FrontendAction over a set of files.
-    clang::tooling::ClangTool tool(optionParser.getCompilations(), sourceFiles);
+    llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem = llvm::vfs::getRealFileSystem();
+    if(headerIndex) {
+        fileSystem = headerIndex->createFileSystem(fileSystem);
+    }
+    if(sysrootImage) {
+        fileSystem = sysrootImage->createFileSystem(fileSystem);
+    }
+    clang::tooling::ClangTool tool(compilations, sourceFiles,
+                                   std::make_shared<clang::PCHContainerOperations>(), fileSystem);
 
 // Print all compile commad - For debugging
 //    std::vector<clang::tooling::CompileCommand> cc = optionParser.getCompilations().getCompileCommands(sourceFiles.at(0));
@@ -52,8 +477,26 @@ int main(int argc, const char **argv) {
 //        }
 //    }
 
+    for(const auto& each : extraArguments) {
+        // Adjusters see the file name of the compile command, Which might differ from the given source path
+        const std::string fileName = compilations.getCompileCommands(each.first).front().Filename;
+        const clang::tooling::ArgumentsAdjuster insertArguments =
+            clang::tooling::getInsertArgumentAdjuster(each.second, clang::tooling::ArgumentInsertPosition::END);
+        tool.appendArgumentsAdjuster([fileName, insertArguments](const clang::tooling::CommandLineArguments& args,
+                                                                 llvm::StringRef file) {
+            return (file == fileName) ? insertArguments(args, file) : args;
+        });
+    }
+
+    CompactDiagnosticConsumer diagnosticConsumer;
+    if(settings.compactDiagnostics) {
+        tool.setDiagnosticConsumer(&diagnosticConsumer);
+    }
+
     // Run would start FrontEnd action on the given source file with compile commands
-    tool.run(clang::tooling::newFrontendActionFactory<CustomFrontendAction>().get());
+    CustomFrontendActionFactory actionFactory(settings);
+    tool.run(&actionFactory);
+    finishRun();
 
     return 0;
 }
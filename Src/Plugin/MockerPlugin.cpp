@@ -0,0 +1,113 @@
+/**
+  * @file: MockerPlugin.cpp
+  * @brief: The MockerPlugin runs the CustomASTConsumer inside a normal clang compile(-fplugin), So mocks are collected
+  *         from the AST the compiler builds anyway instead of parsing every translation unit a second time
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <iostream>
+
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Frontend/FrontendPluginRegistry.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include "DriverUtilities.hpp"
+#include "MockerPlugin.hpp"
+#include "Sharding.hpp"
+
+MockerPluginConsumer::MockerPluginConsumer(clang::CompilerInstance& ci, const ParserSettings& settings,
+                                           std::unique_ptr<MockModel> model, const std::string& shardFile)
+    : CustomASTConsumer(ci.getSourceManager(), settings)
+    , m_compilerInstance(ci)
+    , m_model(std::move(model))
+    , m_shardFile(shardFile) {
+}
+
+void MockerPluginConsumer::HandleTranslationUnit(clang::ASTContext& context) {
+    CustomASTConsumer::HandleTranslationUnit(context);
+
+    // Same entry as a batch run writes for the translation unit, So --merge-shards takes both
+    const clang::SourceManager& sourceManager = context.getSourceManager();
+    llvm::SmallString<256> mainFile(sourceManager.getFileEntryForID(sourceManager.getMainFileID())->getName());
+    llvm::sys::fs::make_absolute(mainFile);
+    const bool success = ! m_compilerInstance.getDiagnostics().hasErrorOccurred();
+    std::vector<ShardEntry> entries(1);
+    entries.front() = {mainFile.str(), success, std::move(*m_model)};
+    if(! Sharding::writeShard(m_shardFile, entries)) {
+        std::cerr << "Unable to write shard file " << m_shardFile << std::endl;
+    }
+}
+
+bool MockerPluginAction::ParseArgs(const clang::CompilerInstance& ci, const std::vector<std::string>& arguments) {
+    for(const auto& each : arguments) {
+        llvm::StringRef argument(each);
+        if(argument.consume_front("shard-dir=") && ! argument.empty()) {
+            m_shardDirectory = argument;
+            continue;
+        }
+
+        clang::DiagnosticsEngine& diagnostics = ci.getDiagnostics();
+        if(argument.consume_front("mock-policy=") && ! argument.empty()) {
+            m_mockPolicy = std::make_unique<MockPolicy>();
+            std::string errorMessage;
+            if(m_mockPolicy->load(argument, false, errorMessage)) {
+                continue;
+            }
+            diagnostics.Report(diagnostics.getCustomDiagID(clang::DiagnosticsEngine::Error, "%0")) << errorMessage;
+            return false;
+        }
+
+        const unsigned diagnosticID = diagnostics.getCustomDiagID(clang::DiagnosticsEngine::Error,
+                                                                  "invalid argument '%0' of plugin auto-dep-mocker");
+        diagnostics.Report(diagnosticID) << each;
+        return false;
+    }
+
+    // Every compile would append to the same mock files of ./GeneratedMocks, Only the merge of the shards writes them
+    if(m_shardDirectory.empty()) {
+        clang::DiagnosticsEngine& diagnostics = ci.getDiagnostics();
+        diagnostics.Report(diagnostics.getCustomDiagID(clang::DiagnosticsEngine::Error,
+                                                       "plugin auto-dep-mocker requires the argument shard-dir=<directory>"));
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<clang::ASTConsumer> MockerPluginAction::CreateASTConsumer(clang::CompilerInstance& ci,
+                                                                          llvm::StringRef inFile) {
+    // Nobody answers questions during a build, And the compile needs every function body
+    ParserSettings settings;
+    settings.askInteractiveMode = false;
+    settings.printGenerationBanner = false;
+    settings.skipFunctionBodiesOutsideMainFile = false;
+    settings.mockPolicy = m_mockPolicy.get();
+
+    // One shard file per source file, A rebuild of the source file replaces its shard file
+    llvm::SmallString<256> sourceFile(inFile);
+    llvm::sys::fs::make_absolute(sourceFile);
+    llvm::SmallString<256> shardFile(m_shardDirectory);
+    llvm::sys::path::append(shardFile, DriverUtilities::computeHash({sourceFile.str()}) + ".shard");
+    DriverUtilities::createDirectories(m_shardDirectory);
+
+    auto model = std::make_unique<MockModel>();
+    settings.modelSink = model.get();
+    return std::make_unique<MockerPluginConsumer>(ci, settings, std::move(model), shardFile.str());
+}
+
+static clang::FrontendPluginRegistry::Add<MockerPluginAction> registration("auto-dep-mocker",
+    "Generate mocks of the dependencies of each translation unit while compiling");
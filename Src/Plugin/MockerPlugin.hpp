@@ -0,0 +1,92 @@
+/**
+  * @file: MockerPlugin.hpp
+  * @brief: The MockerPlugin runs the CustomASTConsumer inside a normal clang compile(-fplugin), So mocks are collected
+  *         from the AST the compiler builds anyway instead of parsing every translation unit a second time
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Usage: clang++ -fplugin=libAutoDepMockerPlugin.so -Xclang -plugin-arg-auto-dep-mocker -Xclang shard-dir=<directory>
+//        [-Xclang -plugin-arg-auto-dep-mocker -Xclang <argument>]... <flags>
+// Arguments:
+//   shard-dir=<directory> - Required. Write the mock information of the translation unit to a shard file in the
+//                           directory. Mock files are shared by the translation units, Compiles must not write them
+//                           one by one. AutoDepMocker --merge-shards <directory>/*.shard -- generates them once the
+//                           build is done
+//   mock-policy=<file>    - Decide which files and symbols are mocked by the rules of the policy file(See MockPolicy)
+
+#ifndef MOCKER_PLUGIN_HPP_
+#define MOCKER_PLUGIN_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/FrontendAction.h"
+
+#include "CustomASTConsumer.hpp"
+#include "MockGeneratorTypes.hpp"
+#include "MockPolicy.hpp"
+
+// Collects the model of the translation unit like CustomASTConsumer and writes it to a shard file
+class MockerPluginConsumer : public CustomASTConsumer {
+public:
+
+    /** Constructor
+     * @arg ci: Compiler instance of the compile
+     * @arg settings: Settings whose modelSink is model
+     * @arg model: Receives the mock information of the translation unit
+     * @arg shardFile: Shard file the model is written to
+     */
+    explicit MockerPluginConsumer(clang::CompilerInstance& ci, const ParserSettings& settings,
+                                  std::unique_ptr<MockModel> model, const std::string& shardFile);
+    ~MockerPluginConsumer() = default;
+    MockerPluginConsumer& operator =(const MockerPluginConsumer&) = delete;
+    MockerPluginConsumer(const MockerPluginConsumer&) = delete;
+
+    void HandleTranslationUnit(clang::ASTContext& context) override;
+
+private:
+    clang::CompilerInstance& m_compilerInstance;
+    std::unique_ptr<MockModel> m_model;
+    std::string m_shardFile;
+};
+
+class MockerPluginAction : public clang::PluginASTAction {
+public:
+
+    explicit MockerPluginAction() = default;
+    ~MockerPluginAction() = default;
+    MockerPluginAction& operator =(const MockerPluginAction&) = delete;
+    MockerPluginAction(const MockerPluginAction&) = delete;
+
+    // Arguments given with -plugin-arg-auto-dep-mocker, Reports unknown ones as errors
+    bool ParseArgs(const clang::CompilerInstance& ci, const std::vector<std::string>& arguments) override;
+
+    // Runs after code generation of every compile the plugin is loaded into, No -add-plugin required
+    ActionType getActionType() override {
+        return AddAfterMainAction;
+    }
+
+protected:
+    std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(clang::CompilerInstance& ci, llvm::StringRef inFile) override;
+
+private:
+    std::string m_shardDirectory;
+    std::unique_ptr<MockPolicy> m_mockPolicy;
+};
+
+#endif // MOCKER_PLUGIN_HPP_
@@ -0,0 +1,159 @@
+/**
+  * @file: LoggerTest.cpp
+  * @brief: Records reach the log file of the configured level and format, Also from children forked while other
+  *         threads are logging
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "Logger.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+std::vector<std::string> readLines(const std::string& fileName) {
+    std::vector<std::string> lines;
+    std::ifstream file(fileName);
+    std::string line;
+    while(std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Wait up to 10 seconds for the child, Returns false when it hangs
+bool waitForChild(const pid_t pid) {
+    int status = 0;
+    for(unsigned waited = 0; waited < 10000; waited++) {
+        if(pid == ::waitpid(pid, &status, WNOHANG)) {
+            return WIFEXITED(status) && (0 == WEXITSTATUS(status));
+        }
+        ::usleep(1000);
+    }
+    ::kill(pid, SIGKILL);
+    ::waitpid(pid, &status, 0);
+    return false;
+}
+
+}
+
+TEST_CASE(Logger, AppendOrTruncate) {
+    const std::string logFile = UnitTest::getTemporaryPath("log");
+
+    Logger::configure(logFile, LogLevel::Info, LogFormat::Text, true);
+    Logger::write(LogLevel::Info, "first");
+    Logger::flush();
+    Logger::configure(logFile, LogLevel::Info, LogFormat::Text);
+    Logger::write(LogLevel::Error, "second");
+    Logger::flush();
+    EXPECT(readLines(logFile) == std::vector<std::string>({"INFO: first", "ERROR: second"}));
+
+    Logger::configure(logFile, LogLevel::Info, LogFormat::Text, true);
+    Logger::write(LogLevel::Warn, "third");
+    Logger::flush();
+    EXPECT(readLines(logFile) == std::vector<std::string>({"WARN: third"}));
+
+    Logger::configure(logFile, LogLevel::Off, LogFormat::Text);
+    llvm::sys::fs::remove(logFile);
+}
+
+TEST_CASE(Logger, RecordsBelowTheLevelAreDropped) {
+    const std::string logFile = UnitTest::getTemporaryPath("log");
+
+    Logger::configure(logFile, LogLevel::Warn, LogFormat::Text, true);
+    EXPECT(! Logger::isEnabled(LogLevel::Info));
+    EXPECT(Logger::isEnabled(LogLevel::Error));
+    LOG_DEBUG("debug");
+    LOG_INFO("info");
+    LOG_WARN("warn " << 1);
+    LOG_ERROR("error " << 2);
+    Logger::flush();
+    EXPECT(readLines(logFile) == std::vector<std::string>({"WARN: warn 1", "ERROR: error 2"}));
+
+    Logger::configure(logFile, LogLevel::Off, LogFormat::Text);
+    llvm::sys::fs::remove(logFile);
+}
+
+TEST_CASE(Logger, JsonLinesAreEscaped) {
+    const std::string logFile = UnitTest::getTemporaryPath("log");
+
+    Logger::configure(logFile, LogLevel::Debug, LogFormat::JsonLines, true);
+    Logger::write(LogLevel::Debug, "a \"quoted\"\tline\n");
+    Logger::flush();
+    const std::vector<std::string> lines = readLines(logFile);
+    EXPECT(1 == lines.size());
+    EXPECT(! lines.empty() && (std::string::npos != lines[0].find("\"level\":\"debug\"")));
+    EXPECT(! lines.empty() && (std::string::npos != lines[0].find("\"message\":\"a \\\"quoted\\\"\\tline\\n\"}")));
+
+    Logger::configure(logFile, LogLevel::Off, LogFormat::Text);
+    llvm::sys::fs::remove(logFile);
+}
+
+// Forked children used to inherit slots claimed by the other threads, Their records never reached the log file
+// and they could hang on a mutex held by the writer thread at the time of the fork
+TEST_CASE(Logger, ForkWhileLogging) {
+    const std::string logFile = UnitTest::getTemporaryPath("log");
+    Logger::configure(logFile, LogLevel::Info, LogFormat::Text, true);
+
+    std::atomic<bool> stop = {false};
+    std::vector<std::thread> producers;
+    for(unsigned i = 0; i < 4; i++) {
+        producers.emplace_back([&stop]() {
+            while(! stop.load(std::memory_order_relaxed)) {
+                Logger::write(LogLevel::Info, "parent");
+            }
+        });
+    }
+
+    const unsigned childCount = 200;
+    unsigned finished = 0;
+    for(unsigned i = 0; i < childCount; i++) {
+        const pid_t pid = ::fork();
+        if(0 == pid) {
+            Logger::write(LogLevel::Info, "child");
+            Logger::flush();
+            ::_exit(0);
+        }
+        finished += (pid > 0) && waitForChild(pid);
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    for(auto& each : producers) {
+        each.join();
+    }
+    Logger::flush();
+    EXPECT(childCount == finished);
+
+    unsigned childRecords = 0;
+    for(const auto& each : readLines(logFile)) {
+        childRecords += ("INFO: child" == each);
+    }
+    EXPECT(childCount == childRecords);
+
+    Logger::configure(logFile, LogLevel::Off, LogFormat::Text);
+    llvm::sys::fs::remove(logFile);
+}
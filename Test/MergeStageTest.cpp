@@ -0,0 +1,115 @@
+/**
+  * @file: MergeStageTest.cpp
+  * @brief: The merge stage gives the model of merging in position order, Whatever the order models arrive in
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "MergeStage.hpp"
+#include "MockModelMerger.hpp"
+#include "RandomModel.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+MockModel mergeInOrder(const std::vector<MockModel>& models) {
+    MockModelMerger merger;
+    MockModel merged;
+    for(const auto& each : models) {
+        MockModel copy = each;
+        merger.merge(merged, std::move(copy));
+    }
+    return merged;
+}
+
+// Push the models in a random order and compare with merging them in position order
+void checkArrivalOrders(const std::size_t capacity, const unsigned seed) {
+    std::mt19937 random(seed);
+    for(unsigned round = 0; round < 50; round++) {
+        std::vector<MockModel> models;
+        for(unsigned i = 0; i < 1 + (round % 12); i++) {
+            models.push_back(RandomModel::makeModel(random));
+        }
+        const std::string expected = RandomModel::serialize(mergeInOrder(models));
+
+        std::vector<std::size_t> arrivalOrder(models.size());
+        std::iota(arrivalOrder.begin(), arrivalOrder.end(), 0);
+        std::shuffle(arrivalOrder.begin(), arrivalOrder.end(), random);
+
+        MergeStage mergeStage(capacity);
+        for(const std::size_t position : arrivalOrder) {
+            MockModel copy = models[position];
+            mergeStage.push(position, std::move(copy));
+        }
+        EXPECT(expected == RandomModel::serialize(mergeStage.finish()));
+    }
+}
+
+}
+
+TEST_CASE(MergeStage, MergesOnCallingThread) {
+    checkArrivalOrders(0, 3);
+}
+
+TEST_CASE(MergeStage, MergesOnMergeThread) {
+    checkArrivalOrders(2, 4);
+}
+
+TEST_CASE(MergeStage, MissingPositionsKeepOrder) {
+    std::mt19937 random(5);
+    std::vector<MockModel> models;
+    for(unsigned i = 0; i < 6; i++) {
+        models.push_back(RandomModel::makeModel(random));
+    }
+
+    // Positions 1 and 4 never arrive(e.g. failed translation units)
+    MergeStage mergeStage(0);
+    for(const std::size_t position : {5, 0, 3, 2}) {
+        MockModel copy = models[position];
+        mergeStage.push(position, std::move(copy));
+    }
+    const std::string expected = RandomModel::serialize(mergeInOrder({models[0], models[2], models[3], models[5]}));
+    EXPECT(expected == RandomModel::serialize(mergeStage.finish()));
+}
+
+TEST_CASE(MergeStage, ConcurrentProducers) {
+    std::mt19937 random(6);
+    std::vector<MockModel> models;
+    for(unsigned i = 0; i < 40; i++) {
+        models.push_back(RandomModel::makeModel(random));
+    }
+    const std::string expected = RandomModel::serialize(mergeInOrder(models));
+
+    // Each thread pushes every fourth position, Arrival order depends on the scheduler
+    MergeStage mergeStage(3);
+    std::vector<std::thread> producers;
+    for(std::size_t first = 0; first < 4; first++) {
+        producers.emplace_back([&models, &mergeStage, first]() {
+            for(std::size_t position = first; position < models.size(); position += 4) {
+                MockModel copy = models[position];
+                mergeStage.push(position, std::move(copy));
+            }
+        });
+    }
+    for(auto& each : producers) {
+        each.join();
+    }
+    EXPECT(expected == RandomModel::serialize(mergeStage.finish()));
+}
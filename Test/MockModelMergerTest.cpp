@@ -0,0 +1,101 @@
+/**
+  * @file: MockModelMergerTest.cpp
+  * @brief: Merging is associative and mergeAll() gives the result of merging the models one after another in
+  *         position order, So the mock files do not depend on how translation units are grouped
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <vector>
+
+#include "MockModelMerger.hpp"
+#include "RandomModel.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+// Merge the models one after another in their order
+MockModel mergeInOrder(const std::vector<MockModel>& models) {
+    MockModelMerger merger;
+    MockModel merged;
+    for(const auto& each : models) {
+        MockModel copy = each;
+        merger.merge(merged, std::move(copy));
+    }
+    return merged;
+}
+
+}
+
+TEST_CASE(MockModelMerger, KeepsFirstEntry) {
+    MethodInfo first;
+    first.name = "foo";
+    first.returnType = "int";
+    MethodInfo second = first;
+    second.returnType = "long";
+
+    MockModel target;
+    target.classMethodInfo["ns::Foo"] = {first};
+    target.includes["a.h"] = {"b.h"};
+    MockModel source;
+    source.classMethodInfo["ns::Foo"] = {second};
+    source.includes["a.h"] = {"c.h", "b.h"};
+
+    MockModelMerger merger;
+    merger.merge(target, std::move(source));
+    EXPECT(1 == target.classMethodInfo["ns::Foo"].size());
+    EXPECT("int" == target.classMethodInfo["ns::Foo"].front().returnType);
+    EXPECT((std::vector<InternedString>{"b.h", "c.h"}) == target.includes["a.h"]);
+}
+
+TEST_CASE(MockModelMerger, MergeIsAssociative) {
+    std::mt19937 random(1);
+    for(unsigned round = 0; round < 100; round++) {
+        const MockModel a = RandomModel::makeModel(random);
+        const MockModel b = RandomModel::makeModel(random);
+        const MockModel c = RandomModel::makeModel(random);
+        MockModelMerger merger;
+
+        // (a + b) + c
+        MockModel left = a;
+        MockModel copy = b;
+        merger.merge(left, std::move(copy));
+        copy = c;
+        merger.merge(left, std::move(copy));
+
+        // a + (b + c)
+        MockModel right = b;
+        copy = c;
+        merger.merge(right, std::move(copy));
+        MockModel leftFirst = a;
+        merger.merge(leftFirst, std::move(right));
+
+        EXPECT(RandomModel::serialize(left) == RandomModel::serialize(leftFirst));
+    }
+}
+
+TEST_CASE(MockModelMerger, MergeAllMergesInPositionOrder) {
+    std::mt19937 random(2);
+    for(unsigned round = 0; round < 50; round++) {
+        std::vector<MockModel> models;
+        for(unsigned i = 0; i < 1 + (round % 11); i++) {
+            models.push_back(RandomModel::makeModel(random));
+        }
+        const std::string expected = RandomModel::serialize(mergeInOrder(models));
+
+        MockModelMerger merger;
+        EXPECT(expected == RandomModel::serialize(merger.mergeAll(std::vector<MockModel>(models), 1 + (round % 3))));
+    }
+}
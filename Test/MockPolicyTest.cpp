@@ -0,0 +1,146 @@
+/**
+  * @file: MockPolicyTest.cpp
+  * @brief: Rules of the mock policy, The longest matching text decides, deny wins on equal length and
+  *         '^'/'$' anchor a text at the start/end
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <fstream>
+#include <string>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "MockPolicy.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+using Decision = MockPolicy::Decision;
+
+// Write the rules to a policy file and load it, Returns false when the rules are rejected
+bool loadRules(MockPolicy& policy, const std::string& rules) {
+    const std::string policyFile = UnitTest::getTemporaryPath("policy");
+    {
+        std::ofstream file(policyFile);
+        file << rules;
+    }
+    std::string errorMessage;
+    const bool loaded = policy.load(policyFile, false, errorMessage);
+    llvm::sys::fs::remove(policyFile);
+    return loaded;
+}
+
+}
+
+TEST_CASE(MockPolicy, NoRuleMatches) {
+    MockPolicy emptyPolicy;
+    EXPECT(loadRules(emptyPolicy, "# Nothing\n\n"));
+    EXPECT(Decision::None == emptyPolicy.decidePath("/src/a.h"));
+    EXPECT(Decision::None == emptyPolicy.decideSymbol("ns::Foo"));
+
+    MockPolicy policy;
+    EXPECT(loadRules(policy, "deny path /generated/\n"));
+    EXPECT(Decision::None == policy.decidePath("/src/a.h"));
+    EXPECT(Decision::None == policy.decideSymbol("ns::Foo")); // Path rules do not apply to symbols
+}
+
+TEST_CASE(MockPolicy, InvalidRulesAreRejected) {
+    MockPolicy unknownAction;
+    EXPECT(! loadRules(unknownAction, "mock path /src/\n"));
+    MockPolicy unknownKind;
+    EXPECT(! loadRules(unknownKind, "allow file /src/\n"));
+    MockPolicy missingText;
+    EXPECT(! loadRules(missingText, "deny symbol\n"));
+}
+
+TEST_CASE(MockPolicy, LongestMatchDecides) {
+    // Order of the rules does not matter
+    for(const std::string& rules : {std::string("allow path /src/\ndeny path /src/generated/\n"),
+                                    std::string("deny path /src/generated/\nallow path /src/\n")}) {
+        MockPolicy policy;
+        EXPECT(loadRules(policy, rules));
+        EXPECT(Decision::Mock == policy.decidePath("/home/user/src/a.h"));
+        EXPECT(Decision::Skip == policy.decidePath("/home/user/src/generated/b.h"));
+        EXPECT(Decision::None == policy.decidePath("/home/user/include/c.h"));
+    }
+
+    MockPolicy policy;
+    EXPECT(loadRules(policy, "deny symbol ns::\nallow symbol ns::Foo\n"));
+    EXPECT(Decision::Mock == policy.decideSymbol("ns::Foo::bar"));
+    EXPECT(Decision::Skip == policy.decideSymbol("ns::Bar::baz"));
+}
+
+TEST_CASE(MockPolicy, LongestMatchThroughFailureLinks) {
+    // "abcd" is followed in the trie while reading "abce", The shorter "bce" is found through the failure links
+    MockPolicy policy;
+    EXPECT(loadRules(policy, "deny symbol abcd\nallow symbol bce\nallow symbol cd\n"));
+    EXPECT(Decision::Mock == policy.decideSymbol("xabcex"));
+    EXPECT(Decision::Skip == policy.decideSymbol("xabcdx"));
+    EXPECT(Decision::Mock == policy.decideSymbol("xbcdx"));
+    EXPECT(Decision::None == policy.decideSymbol("abc"));
+}
+
+TEST_CASE(MockPolicy, DenyWinsOnEqualLength) {
+    for(const std::string& rules : {std::string("allow path foo\ndeny path bar\n"),
+                                    std::string("deny path bar\nallow path foo\n")}) {
+        MockPolicy policy;
+        EXPECT(loadRules(policy, rules));
+        EXPECT(Decision::Skip == policy.decidePath("/foo/bar.h"));
+        EXPECT(Decision::Mock == policy.decidePath("/foo/baz.h"));
+    }
+
+    // Same text allowed and denied
+    for(const std::string& rules : {std::string("allow symbol Foo\ndeny symbol Foo\n"),
+                                    std::string("deny symbol Foo\nallow symbol Foo\n")}) {
+        MockPolicy policy;
+        EXPECT(loadRules(policy, rules));
+        EXPECT(Decision::Skip == policy.decideSymbol("ns::Foo"));
+    }
+}
+
+TEST_CASE(MockPolicy, AnchoredTexts) {
+    MockPolicy policy;
+    EXPECT(loadRules(policy, "deny symbol ^std::\nallow path .hpp$\nallow symbol ^exact$\n"));
+
+    EXPECT(Decision::Skip == policy.decideSymbol("std::vector::push_back"));
+    EXPECT(Decision::None == policy.decideSymbol("mystd::vector"));
+
+    EXPECT(Decision::Mock == policy.decidePath("/src/a.hpp"));
+    EXPECT(Decision::None == policy.decidePath("/src/a.hpp.orig"));
+
+    EXPECT(Decision::Mock == policy.decideSymbol("exact"));
+    EXPECT(Decision::None == policy.decideSymbol("inexact"));
+    EXPECT(Decision::None == policy.decideSymbol("exactly"));
+}
+
+TEST_CASE(MockPolicy, RecordedAnswersMatchExactPaths) {
+    const std::string policyFile = UnitTest::getTemporaryPath("answers");
+    std::string errorMessage;
+    {
+        MockPolicy policy;
+        EXPECT(policy.load(policyFile, true, errorMessage)); // Missing file gives an empty policy
+        policy.recordAnswer("/src/a.h", true);
+        policy.recordAnswer("/src/b.h", false);
+        EXPECT(policy.save());
+    }
+
+    MockPolicy policy;
+    EXPECT(policy.load(policyFile, false, errorMessage));
+    EXPECT(Decision::Mock == policy.decidePath("/src/a.h"));
+    EXPECT(Decision::Skip == policy.decidePath("/src/b.h"));
+    EXPECT(Decision::None == policy.decidePath("/other/src/a.h"));
+    llvm::sys::fs::remove(policyFile);
+}
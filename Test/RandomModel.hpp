@@ -0,0 +1,124 @@
+/**
+  * @file: RandomModel.hpp
+  * @brief: Random mock models for the tests of merging. Models look like those of the AST visitor(no duplicates
+  *         within a list), But entries overlap between models and equal keys carry different properties
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#ifndef RANDOM_MODEL_HPP_
+#define RANDOM_MODEL_HPP_
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+
+#include "MockGeneratorTypes.hpp"
+#include "MockModelMerger.hpp"
+#include "MockModelSerializer.hpp"
+
+namespace RandomModel {
+
+// One of count names, Few names make models overlap
+inline std::string pick(std::mt19937& random, const std::string& prefix, const unsigned count) {
+    return prefix + std::to_string(random() % count);
+}
+
+inline std::list<VariableInfoHierarchy> makeFields(std::mt19937& random, const unsigned depth) {
+    std::list<VariableInfoHierarchy> fields;
+    std::set<std::string> names;
+    for(unsigned i = 0; depth && (i < random() % 3); i++) {
+        const std::string name = pick(random, "field", 4);
+        if(names.insert(name).second) {
+            fields.push_back({name, makeFields(random, depth - 1)});
+        }
+    }
+    return fields;
+}
+
+inline std::vector<MethodInfo> makeMethods(std::mt19937& random, const std::string& prefix) {
+    std::vector<MethodInfo> methods;
+    std::set<std::vector<uint32_t>> signatures;
+    for(unsigned i = 0; i < 4; i++) {
+        MethodInfo methodInfo;
+        methodInfo.name = pick(random, prefix, 6);
+        methodInfo.returnType = pick(random, "Type", 100); // Tells which model an entry was taken from
+        methodInfo.isConst = (0 == random() % 2);
+        methodInfo.args = {pick(random, "Arg", 2)};
+        if(signatures.insert(MockModelMerger::getSignatureKey(methodInfo)).second) {
+            methods.push_back(methodInfo);
+        }
+    }
+    return methods;
+}
+
+inline MockModel makeModel(std::mt19937& random) {
+    MockModel model;
+    std::set<std::string> fileNames;
+    for(unsigned i = 0; i < 3; i++) {
+        const std::string fileName = pick(random, "File", 4);
+        if(! fileNames.insert(fileName).second) {
+            continue;
+        }
+
+        std::vector<InternedString>& includes = model.includes[fileName];
+        for(unsigned j = 0; j < 4; j++) {
+            const InternedString include = pick(random, "Include", 8);
+            if(includes.end() == std::find(includes.begin(), includes.end(), include)) {
+                includes.push_back(include);
+            }
+        }
+
+        const std::string className = "ns::Class" + fileName;
+        ClassInfo& classInfo = model.classInfo[className];
+        classInfo.name = "Class" + fileName;
+        classInfo.fullName = className;
+        classInfo.filename = pick(random, "Header", 100);
+        model.classMethodInfo[className] = makeMethods(random, "method");
+        model.cFunctionInfo[fileName] = makeMethods(random, "function");
+
+        std::vector<enumProperties>& enums = model.enumInfo[fileName];
+        for(unsigned j = 0; j < 2; j++) {
+            enumProperties enumInfo;
+            enumInfo.enumName = pick(random, "Enum", 3);
+            enumInfo.enumFullName = pick(random, "ns::Enum", 100);
+            for(unsigned k = 0; k < 3; k++) {
+                const InternedString value = pick(random, "Value", 6);
+                if(enumInfo.enumValues.end() == std::find(enumInfo.enumValues.begin(), enumInfo.enumValues.end(), value)) {
+                    enumInfo.enumValues.push_back(value);
+                }
+            }
+            if(enums.end() == std::find_if(enums.begin(), enums.end(), [&enumInfo](const enumProperties& each) {
+                                   return each.enumName == enumInfo.enumName;
+                               })) {
+                enums.push_back(enumInfo);
+            }
+        }
+
+        model.variableInfo[fileName] = makeFields(random, 3);
+    }
+    return model;
+}
+
+// Models with equal content give equal serializations, Order of every list included
+inline std::string serialize(const MockModel& model) {
+    MockModelSerializer serializer;
+    return serializer.serialize(model);
+}
+
+}
+
+#endif // RANDOM_MODEL_HPP_
@@ -0,0 +1,175 @@
+/**
+  * @file: ShardingTest.cpp
+  * @brief: Source files are distributed largest first to the smallest shard, The distribution only depends on
+  *         file names and sizes
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "Sharding.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+// Directory of source files with given sizes, Removed with all files at the end of the test
+class SourceDirectory {
+public:
+    explicit SourceDirectory()
+        : m_directory(UnitTest::getTemporaryPath("sources")) {
+        llvm::sys::fs::create_directory(m_directory);
+    }
+    ~SourceDirectory() {
+        llvm::sys::fs::remove_directories(m_directory);
+    }
+    SourceDirectory& operator =(const SourceDirectory&) = delete;
+    SourceDirectory(const SourceDirectory&) = delete;
+
+    // Path of the file in the directory, Nothing is created
+    std::string path(const std::string& name) const {
+        return m_directory + "/" + name;
+    }
+
+    // Create the file with the given number of bytes, Returns its path
+    std::string add(const std::string& name, const std::size_t size) const {
+        std::ofstream file(path(name));
+        file << std::string(size, 'x');
+        return path(name);
+    }
+
+private:
+    std::string m_directory;
+};
+
+std::vector<std::string> sorted(std::vector<std::string> files) {
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+}
+
+TEST_CASE(Sharding, ShardsPartitionTheFiles) {
+    const SourceDirectory sources;
+    std::vector<std::string> files;
+    for(unsigned i = 0; i < 20; i++) {
+        files.push_back(sources.add("file" + std::to_string(i) + ".cpp", (i * 7) % 11));
+    }
+
+    for(unsigned count = 1; count <= 6; count++) {
+        std::vector<std::string> all;
+        for(unsigned index = 0; index < count; index++) {
+            const std::vector<std::string> shard = Sharding::selectShard(files, index, count);
+            // Files of a shard keep their original order
+            auto position = files.begin();
+            for(const auto& each : shard) {
+                position = std::find(position, files.end(), each);
+                EXPECT(files.end() != position);
+            }
+            all.insert(all.end(), shard.begin(), shard.end());
+        }
+        // Each file is in exactly one shard
+        EXPECT(sorted(files) == sorted(all));
+    }
+}
+
+TEST_CASE(Sharding, LargestFirstToSmallestShard) {
+    const SourceDirectory sources;
+    const std::vector<std::string> files = {sources.add("f.cpp", 1), sources.add("e.cpp", 2), sources.add("d.cpp", 3),
+                                            sources.add("c.cpp", 7), sources.add("b.cpp", 8), sources.add("a.cpp", 9)};
+
+    // a(9) -> 0, b(8) -> 1, c(7) -> 1, d(3) -> 0, e(2) -> 0, f(1) -> 0, Both shards end with 15 bytes
+    EXPECT(Sharding::selectShard(files, 0, 2) ==
+           std::vector<std::string>({sources.path("f.cpp"), sources.path("e.cpp"), sources.path("d.cpp"),
+                                     sources.path("a.cpp")}));
+    EXPECT(Sharding::selectShard(files, 1, 2) ==
+           std::vector<std::string>({sources.path("c.cpp"), sources.path("b.cpp")}));
+}
+
+TEST_CASE(Sharding, EqualSizesAreOrderedByName) {
+    const SourceDirectory sources;
+    const std::vector<std::string> files = {sources.add("d.cpp", 5), sources.add("c.cpp", 5), sources.add("b.cpp", 5),
+                                            sources.add("a.cpp", 5)};
+
+    // a -> 0, b -> 1, c -> 0, d -> 1, Ties between shards go to the lower index
+    EXPECT(Sharding::selectShard(files, 0, 2) == std::vector<std::string>({sources.path("c.cpp"), sources.path("a.cpp")}));
+    EXPECT(Sharding::selectShard(files, 1, 2) == std::vector<std::string>({sources.path("d.cpp"), sources.path("b.cpp")}));
+}
+
+TEST_CASE(Sharding, IndependentOfInputOrder) {
+    const SourceDirectory sources;
+    std::vector<std::string> files;
+    for(unsigned i = 0; i < 30; i++) {
+        files.push_back(sources.add("file" + std::to_string(i) + ".cpp", (i * 13) % 7));
+    }
+
+    std::mt19937 random(3);
+    for(unsigned count = 1; count <= 5; count++) {
+        std::vector<std::vector<std::string>> expected;
+        for(unsigned index = 0; index < count; index++) {
+            expected.push_back(sorted(Sharding::selectShard(files, index, count)));
+        }
+        for(unsigned round = 0; round < 10; round++) {
+            std::vector<std::string> shuffled = files;
+            std::shuffle(shuffled.begin(), shuffled.end(), random);
+            for(unsigned index = 0; index < count; index++) {
+                EXPECT(expected[index] == sorted(Sharding::selectShard(shuffled, index, count)));
+            }
+        }
+    }
+}
+
+TEST_CASE(Sharding, MissingFilesCountAsEmpty) {
+    const SourceDirectory sources;
+    const std::vector<std::string> files = {sources.path("missing2.cpp"), sources.add("present.cpp", 10),
+                                            sources.path("missing1.cpp")};
+
+    // present(10) -> 0, Both missing files go to the empty shard
+    EXPECT(Sharding::selectShard(files, 0, 2) == std::vector<std::string>({sources.path("present.cpp")}));
+    EXPECT(Sharding::selectShard(files, 1, 2) ==
+           std::vector<std::string>({sources.path("missing2.cpp"), sources.path("missing1.cpp")}));
+}
+
+TEST_CASE(Sharding, MoreShardsThanFiles) {
+    const SourceDirectory sources;
+    const std::vector<std::string> files = {sources.add("b.cpp", 1), sources.add("a.cpp", 2)};
+
+    EXPECT(Sharding::selectShard(files, 0, 4) == std::vector<std::string>({sources.path("a.cpp")}));
+    EXPECT(Sharding::selectShard(files, 1, 4) == std::vector<std::string>({sources.path("b.cpp")}));
+    EXPECT(Sharding::selectShard(files, 2, 4).empty());
+    EXPECT(Sharding::selectShard(files, 3, 4).empty());
+    EXPECT(Sharding::selectShard(files, 0, 1) == files);
+}
+
+TEST_CASE(Sharding, ParseShard) {
+    unsigned index = 0;
+    unsigned count = 0;
+    EXPECT(Sharding::parseShard("2/3", index, count));
+    EXPECT((1 == index) && (3 == count));
+    EXPECT(Sharding::parseShard("1/1", index, count));
+    EXPECT((0 == index) && (1 == count));
+
+    EXPECT(! Sharding::parseShard("0/3", index, count));
+    EXPECT(! Sharding::parseShard("4/3", index, count));
+    EXPECT(! Sharding::parseShard("3", index, count));
+    EXPECT(! Sharding::parseShard("a/3", index, count));
+    EXPECT(! Sharding::parseShard("1/", index, count));
+}
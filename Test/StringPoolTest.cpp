@@ -0,0 +1,124 @@
+/**
+  * @file: StringPoolTest.cpp
+  * @brief: Equal strings give equal handles, Also when interned concurrently. reset() starts a new generation and
+  *         constants are interned again
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StringPool.hpp"
+#include "UnitTest.hpp"
+
+TEST_CASE(StringPool, EqualStringsGiveEqualHandles) {
+    const uint32_t foo = StringPool::intern("foo");
+    EXPECT(foo == StringPool::intern(std::string("fo") + "o"));
+    EXPECT(foo != StringPool::intern("bar"));
+    EXPECT("foo" == StringPool::get(foo));
+
+    // Handle 0 is the empty string
+    EXPECT(0 == StringPool::intern(""));
+    EXPECT(InternedString().empty());
+    EXPECT(InternedString() == InternedString(""));
+    EXPECT(InternedString() == "");
+
+    EXPECT(InternedString("foo") == InternedString(llvm::StringRef("foo")));
+    EXPECT(InternedString("foo") == "foo");
+    EXPECT(InternedString("foo") != "bar");
+    EXPECT(3 == InternedString("foo").size());
+}
+
+TEST_CASE(StringPool, OrderedByContent) {
+    // Interned in reverse order, So the handles are ordered the other way round
+    const InternedString zulu("zulu-order");
+    const InternedString alpha("alpha-order");
+    EXPECT(alpha < zulu);
+    EXPECT(! (zulu < alpha));
+    EXPECT(! (alpha < alpha));
+}
+
+TEST_CASE(StringPool, ConcurrentInterning) {
+    std::vector<std::string> values;
+    for(unsigned i = 0; i < 2000; i++) {
+        values.push_back("value" + std::to_string(i));
+    }
+
+    // Each thread interns all values in its own order
+    const unsigned threadCount = 8;
+    std::vector<std::vector<uint32_t>> handles(threadCount, std::vector<uint32_t>(values.size(), 0));
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < threadCount; t++) {
+        threads.emplace_back([&values, &handles, t]() {
+            std::vector<std::size_t> order(values.size());
+            for(std::size_t i = 0; i < order.size(); i++) {
+                order[i] = i;
+            }
+            std::mt19937 random(t);
+            std::shuffle(order.begin(), order.end(), random);
+            for(const std::size_t each : order) {
+                handles[t][each] = StringPool::intern(values[each]);
+            }
+        });
+    }
+    for(auto& each : threads) {
+        each.join();
+    }
+
+    for(unsigned t = 1; t < threadCount; t++) {
+        EXPECT(handles[0] == handles[t]);
+    }
+    std::vector<uint32_t> distinct = handles[0];
+    std::sort(distinct.begin(), distinct.end());
+    EXPECT(std::unique(distinct.begin(), distinct.end()) == distinct.end());
+    for(std::size_t i = 0; i < values.size(); i++) {
+        EXPECT(values[i] == StringPool::get(handles[0][i]));
+    }
+}
+
+TEST_CASE(StringPool, ResetStartsNewGeneration) {
+    InternedString("before reset");
+    const uint32_t generation = StringPool::getGeneration();
+    StringPool::reset();
+    EXPECT(generation + 1 == StringPool::getGeneration());
+
+    // The empty string is valid in every generation
+    EXPECT(0 == StringPool::intern(""));
+    EXPECT(InternedString().str().empty());
+
+    const InternedString value("after reset");
+    EXPECT(value == "after reset");
+    EXPECT(value == InternedString("after reset"));
+}
+
+TEST_CASE(StringPool, ConstantsAreInternedPerGeneration) {
+    static const InternedConstant constant("constant ");
+    const InternedString before = constant;
+    EXPECT(before == "constant ");
+    EXPECT(before == InternedString(constant));
+
+    // Other strings take the handles of the previous generation first, A cached handle would refer to them
+    StringPool::reset();
+    for(unsigned i = 0; i < 100; i++) {
+        InternedString("other" + std::to_string(i));
+    }
+    const InternedString after = constant;
+    EXPECT(after == "constant ");
+    EXPECT(after == InternedString("constant "));
+}
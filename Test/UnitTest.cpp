@@ -0,0 +1,89 @@
+/**
+  * @file: UnitTest.cpp
+  * @brief: Runs the registered unit tests and reports failed expectations
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+#include <iostream>
+#include <vector>
+
+#include <unistd.h>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/Path.h"
+
+#include "UnitTest.hpp"
+
+namespace {
+
+struct TestCase {
+    std::string group;
+    std::string name;
+    UnitTest::FunctionType function = nullptr;
+};
+
+// Tests register themselves during static initialization, So the list must exist before the first of them
+std::vector<TestCase>& getTestCases() {
+    static std::vector<TestCase> testCases;
+    return testCases;
+}
+
+unsigned failedExpectations = 0;
+
+}
+
+bool UnitTest::add(const char* group, const char* name, FunctionType function) {
+    getTestCases().push_back({group, name, function});
+    return true;
+}
+
+void UnitTest::fail(const char* file, const int line, const char* expression) {
+    std::cerr << file << ":" << line << ": Expected " << expression << std::endl;
+    ++failedExpectations;
+}
+
+int UnitTest::run(const std::string& group) {
+    unsigned testCount = 0;
+    unsigned failedTests = 0;
+    for(const auto& each : getTestCases()) {
+        if(! group.empty() && (group != each.group)) {
+            continue;
+        }
+
+        const unsigned failedBefore = failedExpectations;
+        each.function();
+        ++testCount;
+        const bool passed = (failedBefore == failedExpectations);
+        failedTests += passed ? 0 : 1;
+        std::cout << (passed ? "[PASS] " : "[FAIL] ") << each.group << "." << each.name << std::endl;
+    }
+
+    std::cout << (testCount - failedTests) << " of " << testCount << " tests passed" << std::endl;
+    return ((0 == testCount) || failedTests) ? 1 : 0;
+}
+
+std::string UnitTest::getTemporaryPath(const std::string& name) {
+    static unsigned counter = 0;
+    llvm::SmallString<256> path;
+    llvm::sys::path::system_temp_directory(true, path);
+    llvm::sys::path::append(path, "AutoDepMockerTest." + std::to_string(::getpid()) + "." +
+                            std::to_string(counter++) + "." + name);
+    return path.str().str();
+}
+
+int main(int argc, char** argv) {
+    return UnitTest::run((argc > 1) ? argv[1] : "");
+}
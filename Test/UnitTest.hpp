@@ -0,0 +1,65 @@
+/**
+  * @file: UnitTest.hpp
+  * @brief: Minimal registry of unit tests, The tool itself has no test framework dependency
+  *
+  * Copyright [2023-present] [Bosch Global Software Technologies]
+
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+
+  *     http://www.apache.org/licenses/LICENSE-2.0
+
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  */
+
+// Usage:
+// ------
+// TEST_CASE(Group, Name) {
+//     EXPECT(condition);
+// }
+//
+// AutoDepMockerTest runs all tests, AutoDepMockerTest <group> only the tests of the group(See add_test of CMakeLists.txt)
+
+#ifndef UNIT_TEST_HPP_
+#define UNIT_TEST_HPP_
+
+#include <string>
+
+class UnitTest {
+public:
+    using FunctionType = void (*)();
+
+    // Register a test, Called by TEST_CASE during static initialization
+    static bool add(const char* group, const char* name, FunctionType function);
+
+    // Report a failed expectation of the running test
+    static void fail(const char* file, const int line, const char* expression);
+
+    /** Run
+     * @arg group: Run only the tests of this group, Empty runs all tests
+     * @return int: 0 when every test passed and at least one test ran, 1 otherwise
+     */
+    static int run(const std::string& group);
+
+    // Unique path below the temporary directory, Nothing is created
+    static std::string getTemporaryPath(const std::string& name);
+};
+
+#define TEST_CASE(group, name)                                                                  \
+    static void group##_##name();                                                               \
+    static const bool group##_##name##_registered = UnitTest::add(#group, #name, group##_##name); \
+    static void group##_##name()
+
+#define EXPECT(condition)                                   \
+    do {                                                    \
+        if(! (condition)) {                                 \
+            UnitTest::fail(__FILE__, __LINE__, #condition); \
+        }                                                   \
+    } while(false)
+
+#endif // UNIT_TEST_HPP_